@@ -0,0 +1,167 @@
+/**
+ * columns.hpp - Column-wise compression of tables of structs.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_COLUMNS_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_COLUMNS_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Compresses an array of structs one field at a time: the values of each
+ * listed field are gathered into a column, and every column is compressed
+ * with its own Huffman model. A field's values usually resemble each other
+ * far more than they resemble the neighbouring fields, so this compresses
+ * much better than coding the structs' bytes. Each column is a separate
+ * bitstream, so scanning one field decodes only that field's bits.
+ * @tparam table A std::array of structs with integer fields.
+ * @tparam fields Pointers to the fields to store, e.g. &point::x. Fields
+ *                that are not listed are value-initialized on decoding.
+ */
+template<auto table, auto... fields>
+    requires(table.size() > 0 && sizeof...(fields) > 0)
+class huffman_column_table
+{
+    using usize_t = unsigned long int;
+
+    constexpr static usize_t count = table.size();
+    constexpr static auto field_tuple = std::tuple(fields...);
+
+    template<usize_t f>
+    using field_type = std::remove_cvref_t<
+        decltype(table[0].*std::get<f>(field_tuple))>;
+
+    template<usize_t f, usize_t... i>
+    static auto make_column(std::index_sequence<i...>)
+        -> huffman_wide_compressor<field_type<f>,
+            (table[i].*std::get<f>(field_tuple))...>;
+
+public:
+    using value_type = typename decltype(table)::value_type;
+
+    // The compressor type that holds the f-th field's column.
+    template<usize_t f>
+    using column_type = decltype(make_column<f>(std::make_index_sequence<count>()));
+
+private:
+    template<usize_t f>
+    constexpr static auto column_data = column_type<f>();
+
+    template<usize_t... f>
+    static auto make_iterators(std::index_sequence<f...>)
+        -> std::tuple<typename column_type<f>::decoder...>;
+    using iterators = decltype(make_iterators(
+        std::make_index_sequence<sizeof...(fields)>()));
+
+public:
+    // Iterates over the table, rebuilding one struct per step from the
+    // columns' decoders.
+    class decoder {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = huffman_column_table::value_type;
+
+        decoder() = default;
+        explicit decoder(iterators its) noexcept
+            : m_its(its) {}
+
+        bool operator==(const decoder& other) const noexcept {
+            return std::get<0>(m_its) == std::get<0>(other.m_its);
+        }
+        auto operator*() const noexcept {
+            return get(std::make_index_sequence<sizeof...(fields)>());
+        }
+        decoder& operator++() noexcept {
+            std::apply([](auto&... it) { (++it, ...); }, m_its);
+            return *this;
+        }
+        decoder operator++(int) noexcept {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+    private:
+        template<usize_t... f>
+        value_type get(std::index_sequence<f...>) const noexcept {
+            value_type value {};
+            ((value.*std::get<f>(field_tuple) = *std::get<f>(m_its)), ...);
+            return value;
+        }
+
+        iterators m_its;
+    };
+
+    consteval huffman_column_table() noexcept = default;
+
+    // Returns the number of structs in the table.
+    constexpr static auto size() noexcept {
+        return count;
+    }
+
+    consteval static auto compressed_size() noexcept {
+        return columns_size(std::make_index_sequence<sizeof...(fields)>());
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return count * sizeof(value_type);
+    }
+
+    /**
+     * Returns the f-th field's column (in the order fields were given), to
+     * iterate over that field alone.
+     */
+    template<usize_t f>
+    constexpr static const auto& column() noexcept {
+        return column_data<f>;
+    }
+
+    // Returns the compressed size of the f-th field's column.
+    template<usize_t f>
+    consteval static auto column_size() noexcept {
+        return column_type<f>::compressed_size();
+    }
+
+    /**
+     * Decompresses the f-th field's column alone; the other columns' bits
+     * are never read.
+     * @param out Where to store the field's values; must hold size().
+     */
+    template<usize_t f>
+    static void decode_column(std::span<field_type<f>> out) noexcept {
+        column_data<f>.decode(out);
+    }
+
+    auto begin() const noexcept {
+        return make_decoder(std::make_index_sequence<sizeof...(fields)>(), true);
+    }
+    auto end() const noexcept {
+        return make_decoder(std::make_index_sequence<sizeof...(fields)>(), false);
+    }
+    auto cbegin() const noexcept { return begin(); }
+    auto cend() const noexcept { return end(); }
+
+private:
+    template<usize_t... f>
+    consteval static usize_t columns_size(std::index_sequence<f...>) noexcept {
+        return (column_size<f>() + ...);
+    }
+
+    template<usize_t... f>
+    static decoder make_decoder(std::index_sequence<f...>, bool begin) noexcept {
+        return decoder(iterators(
+            (begin ? column_data<f>.begin() : column_data<f>.end())...));
+    }
+};
+
+template<auto table, auto... fields>
+constexpr auto huffman_compress_columns = huffman_column_table<table, fields...>();
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_COLUMNS_HPP_
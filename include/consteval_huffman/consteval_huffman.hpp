@@ -8,8 +8,14 @@
 #define TCSULLIVAN_CONSTEVAL_HUFFMAN_HPP_
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <concepts>
+#include <cstddef>
+#include <memory>
 #include <span>
+#include <string_view>
 #include <type_traits>
 
 namespace detail
@@ -32,31 +38,11 @@ namespace detail
             return N;
         }
     };
-}
-
-/**
- * Compresses the given data string using Huffman coding, providing a
- * minimal run-time interface for decompressing the data.
- * @tparam raw_data The string of data to be compressed.
- */
-template<auto raw_data>
-    requires(
-        std::same_as<std::remove_cvref_t<decltype(raw_data)>,
-            detail::huffman_string_container<std::remove_cvref_t<decltype(raw_data.data[0])>,
-                raw_data.size()>> &&
-        raw_data.size() > 0)
-class huffman_compressor
-{
-    using size_t = long int;
-    using usize_t = unsigned long int;
 
-    // Note: class internals need to be defined before the public interface.
-    // See the bottom of the class definition for usage.
-private:
     // Node structure used to build a tree for calculating Huffman codes.
-    struct node {
+    struct huffman_node {
         int value = 0;
-        size_t freq = 0;
+        long int freq = 0;
 
         // Below values are indices into the node list
         int parent = -1;
@@ -65,17 +51,21 @@ private:
     };
 
     /**
-     * Builds a list of nodes for every character that appears in the given data.
-     * This list is sorted by increasing frequency.
-     * @return Compile-time allocated array of nodes
+     * Builds a list of nodes for every value with a non-zero frequency.
+     * This list is sorted by increasing frequency, and has at least two nodes.
+     * @param freq Frequencies of each value.
+     * @param count Number of values: 256 bytes, plus any special symbols.
+     * @return Allocated array of nodes, to be freed with delete[].
      */
-    consteval static auto build_node_list() noexcept {
+    constexpr auto huffman_build_node_list(const long int *freq,
+        int count = 256) noexcept
+    {
         // Build a list for counting every occuring value
-        auto list = std::span(new node[256] {}, 256);
-        for (int i = 0; i < 256; i++)
+        auto list = std::span(new huffman_node[count] {}, count);
+        for (int i = 0; i < count; i++) {
             list[i].value = i;
-        for (usize_t i = 0; i < raw_data.size(); i++)
-            list[raw_data[i]].freq++;
+            list[i].freq = freq[i];
+        }
 
         std::sort(list.begin(), list.end(),
             [](const auto& a, const auto& b) { return a.freq < b.freq; });
@@ -86,136 +76,428 @@ private:
         auto fit_size = std::distance(first_valid_node, list.end());
         if (fit_size < 2)
             fit_size = 2;
-        auto fit_list = std::span(new node[fit_size] {}, fit_size);
+        auto fit_list = std::span(new huffman_node[fit_size] {}, fit_size);
         std::copy(first_valid_node, list.end(), fit_list.begin());
         delete[] list.data();
         return fit_list;
     }
 
     /**
-     * Returns the count of how many nodes are in the node tree.
+     * Builds a tree out of a node list, allowing for the calculation of
+     * Huffman codes. The list is consumed.
+     * @return Allocated tree of nodes, root node at index zero, to be freed
+     *         with delete[].
      */
-    consteval static auto tree_count() noexcept {
-        auto list = build_node_list();
+    constexpr auto huffman_build_node_tree(std::span<huffman_node> list) noexcept {
         auto count = list.size() * 2 - 1;
-        delete[] list.data();
-        return count;
-    }
+        auto tree = std::span(new huffman_node[count] {}, count);
 
-    /**
-     * Builds a tree out of the node list, allowing for the calculation of
-     * Huffman codes.
-     * @return Compile-time allocated tree of nodes, root node at index zero.
-     */
-    consteval static auto build_node_tree() noexcept {
-        auto list = build_node_list();
-        auto tree = std::span(new node[tree_count()] {}, tree_count());
-        
-        auto list_end = list.end(); // Track end of list as it shrinks
+        auto first = list.begin(); // The list shrinks from the front
         auto tree_begin = tree.end(); // Build tree from bottom
-        int next_parent_node_value = 0x100; // Give parent nodes unique ids
+        int next_parent_node_value = 0x200; // Give parent nodes unique ids
         while (1) {
             // Create parent node for two least-occuring values
-            node new_node {
+            huffman_node new_node {
                 next_parent_node_value++,
-                list[0].freq + list[1].freq,
+                first[0].freq + first[1].freq,
                 -1,
-                list[0].value,
-                list[1].value
+                first[0].value,
+                first[1].value
             };
 
             // Move the two nodes into the tree and remove them from the list
-            *--tree_begin = list[0];
-            *--tree_begin = list[1];
-            std::copy(list.begin() + 2, list_end--, list.begin());
-            if (std::distance(list.begin(), list_end) == 1) {
-                list.front() = new_node;
+            *--tree_begin = first[0];
+            *--tree_begin = first[1];
+            first += 2;
+            if (first == list.end()) {
+                tree[0] = new_node;
                 break;
             }
 
-            // Insert the parent node back into the list
-            auto insertion_point = std::find_if(list.begin(), list_end - 1,
-                [&new_node](const auto& n) { return n.freq >= new_node.freq; });
-            if (insertion_point != list_end - 1) {
-                *(list_end - 1) = node();
-                std::copy_backward(insertion_point, list_end - 1, list_end);
-            }
-
-            *insertion_point = new_node;
+            // Insert the parent node back into the list, ahead of any nodes
+            // of equal frequency
+            auto insertion_point = std::lower_bound(first, list.end(), new_node.freq,
+                [](const auto& n, long int freq) { return n.freq < freq; });
+            std::copy(first, insertion_point, first - 1);
+            *(insertion_point - 1) = new_node;
+            --first;
         }
 
-        // Connect child nodes to their parents
-        tree[0] = list[0];
-        for (auto iter = tree.begin(); ++iter != tree.end();) {
-            if (iter->parent == -1) {
-                auto parent = std::find_if(tree.begin(), iter,
-                    [&iter](const auto& n) {
-                        return n.left == iter->value || n.right == iter->value;
-                    });
-                if (parent != iter)
-                    iter->parent = std::distance(tree.begin(), parent);
+        // Connect child nodes to their parents: each node's parent is the
+        // first node that names it as a child.
+        auto first_parent = new int[next_parent_node_value] {};
+        std::fill(first_parent, first_parent + next_parent_node_value, -1);
+        for (auto i = tree.size(); i-- > 0;) {
+            for (auto child : {tree[i].left, tree[i].right}) {
+                if (child >= 0)
+                    first_parent[child] = static_cast<int>(i);
             }
         }
+        for (unsigned long int i = 1; i < tree.size(); i++) {
+            auto parent = first_parent[tree[i].value];
+            if (tree[i].parent == -1 && parent != -1 &&
+                static_cast<unsigned long int>(parent) < i)
+            {
+                tree[i].parent = parent;
+            }
+        }
+        delete[] first_parent;
 
         delete[] list.data();
         return tree;
     }
 
     /**
-     * Determines the size of the compressed data.
-     * @return A pair of total bytes used, and bits used in last byte.
+     * Writes the decode tree, used to decompress the data.
+     * Format: three bytes per node.
+     *     1. Node value, 2. Distance to left child, 3. Distance to right child.
+     * @return False if a child distance did not fit in a byte, in which case
+     *         the written tree is unusable.
      */
-    consteval static auto compressed_size_info() noexcept {
-        auto tree = build_node_tree();
-        size_t bytes = 1, bits = 0;
+    constexpr bool huffman_write_decode_tree(std::span<const huffman_node> tree,
+        unsigned char *decode_tree) noexcept
+    {
+        bool fits = true;
+        auto child_distance = [&](unsigned long int i, int child) {
+            unsigned long int j;
+            for (j = i + 1; j < tree.size(); j++) {
+                if (child == tree[j].value)
+                    break;
+            }
+            auto distance = j < tree.size() ? j - i : 0;
+            fits &= distance <= 0xFF;
+            return static_cast<unsigned char>(distance);
+        };
 
-        for (usize_t i = 0; i < raw_data.size(); i++) {
-            auto c = static_cast<int>(raw_data[i]);
-            auto leaf = std::find_if(tree.begin(), tree.end(),
-                [c](const auto& n) { return n.value == c; });
-
-            while (leaf->parent != -1) {
-                if (++bits == 8)
-                    bits = 0, bytes++;
-                leaf = tree.begin() + leaf->parent;
+        for (unsigned long int i = 0; i < tree.size(); i++) {
+            // Only store node value if it represents a data value
+            decode_tree[i * 3] = tree[i].value <= 0xFF ? tree[i].value : 0;
+            // Find the left and right children of this node
+            decode_tree[i * 3 + 1] = child_distance(i, tree[i].left);
+            decode_tree[i * 3 + 2] = child_distance(i, tree[i].right);
+        }
+
+        return fits;
+    }
+
+    /**
+     * Walks the decode tree from its root to the leaf for the next code.
+     * @param table The decode tree.
+     * @param data Byte to read from, advanced past the value's code.
+     * @param bit Bit mask to read from, advanced past the value's code.
+     * @param length Set to the length of the value's code, in bits.
+     * @return The leaf node reached.
+     */
+    inline const unsigned char *huffman_decode_node(const unsigned char *table,
+        const unsigned char *& data, unsigned char& bit,
+        unsigned char& length) noexcept
+    {
+        auto *node = table;
+        int byte = *data;
+        length = 0;
+        do {
+            node += (byte & bit) ? node[2] * 3u : node[1] * 3u;
+            length++;
+            bit >>= 1;
+            if (!bit)
+                bit = 0x80, byte = *++data;
+        } while (node[1] != 0);
+        return node;
+    }
+
+    // Decodes one value by walking the decode tree. See huffman_decode_node().
+    inline int huffman_decode_one(const unsigned char *table,
+        const unsigned char *& data, unsigned char& bit,
+        unsigned char& length) noexcept
+    {
+        return *huffman_decode_node(table, data, bit, length);
+    }
+
+    // Appends text to a buffer, or only measures it if the buffer is null.
+    struct huffman_text_writer {
+        char *out = nullptr;
+        unsigned long int size = 0;
+
+        constexpr void put(std::string_view text) noexcept {
+            for (auto c : text) {
+                if (out)
+                    out[size] = c;
+                size++;
             }
         }
+        constexpr void put(unsigned long long number) noexcept {
+            char digits[20] = {};
+            int count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + number % 10);
+                number /= 10;
+            } while (number > 0);
+            while (count > 0)
+                put(std::string_view(digits + --count, 1));
+        }
+    };
 
-        delete[] tree.data();
-        return std::make_pair(bytes, bits);
+    // Decode trees stored apart from their payloads (see
+    // huffman_options::separate_tree). Identical trees share one instance.
+    template<auto tree, unsigned int alignment>
+    alignas(alignment) inline constexpr auto huffman_shared_tree = tree;
+
+    consteval unsigned long int huffman_round_up(unsigned long int size,
+        unsigned long int multiple) noexcept
+    {
+        return (size + multiple - 1) / multiple * multiple;
     }
 
+    // Writes codes most significant bit first, matching the decoder's reads.
+    // The output must be zero-initialized.
+    struct huffman_bit_writer {
+        unsigned char *data;
+        unsigned char bit = 0x80;
+
+        constexpr void put(unsigned long long code, unsigned int length) noexcept {
+            while (length > 0) {
+                // Fill as much of the current byte as the code allows
+                unsigned int space = std::countr_zero(bit) + 1;
+                unsigned int count = std::min(space, length);
+                length -= count;
+                auto part = (code >> length) & ((1u << count) - 1);
+                *data |= static_cast<unsigned char>(part << (space - count));
+                bit >>= count;
+                if (!bit)
+                    bit = 0x80, data++;
+            }
+        }
+    };
+}
+
+/**
+ * Byte value frequencies to build Huffman codes from, in place of the counts
+ * of the data being compressed. Data compressed with the same frequencies
+ * gets the same codes, so with separate_tree set their decode trees are
+ * shared, and short strings are coded by a realistic model rather than by
+ * their own sparse counts. All zeros (the default) uses the data's counts.
+ */
+struct huffman_frequencies {
+    std::array<long int, 256> counts {};
+
+    consteval bool empty() const noexcept {
+        return std::all_of(counts.begin(), counts.end(),
+            [](auto n) { return n == 0; });
+    }
+};
+
+/**
+ * Frequencies counted from training data, such as a sample of real traffic.
+ * Values that the training data lacks still get codes where they occur, but
+ * then the codes (and tree) differ from the model's.
+ */
+template<detail::huffman_string_container training>
+constexpr auto huffman_frequencies_of = [] {
+    huffman_frequencies f;
+    for (unsigned long int i = 0; i < training.size(); i++)
+        f.counts[static_cast<unsigned char>(training.data[i])]++;
+    return f;
+}();
+
+/**
+ * Options for tuning how huffman_compressor stores its data.
+ */
+struct huffman_options {
+    // Also store the codes in reverse order so that the decoder can step
+    // backwards, making it a std::bidirectional_iterator. This roughly
+    // doubles the size of the compressed payload.
+    bool bidirectional = false;
+
+    // Store the decode tree in its own cache-line aligned array rather than
+    // after the payload, keeping the small, hot table away from the larger
+    // payload. Compressors with identical trees share a single array.
+    bool separate_tree = false;
+
+    // Alignment of data(), in bytes. Aligning to 8 lets a decoder make
+    // aligned word-sized loads from the payload.
+    unsigned int alignment = 1;
+
+    // Alignment of the decode tree, in bytes. The tree is also padded to a
+    // multiple of this size, so 64 gives a table of whole cache lines.
+    // Separate trees are always aligned to at least 64 bytes.
+    unsigned int tree_alignment = 1;
+
+    // The data is only stored compressed if doing so saves at least this
+    // many bytes...
+    unsigned long int min_saved_bytes = 1;
+    // ...and at least this percentage of the uncompressed size...
+    unsigned int min_saved_percent = 0;
+    // ...and at least this many bytes for every 100 bits of codes. Decoding
+    // takes one step down the tree per bit, so this weighs the decoder's run
+    // time against the space saved. Otherwise, the data is stored raw.
+    unsigned int decode_cost = 0;
+
+    // Make begin() and end() iterate over decoded() rather than decoding on
+    // every pass. The data is decompressed once, on first use, so repeated
+    // reads cost no more than raw data at the price of uncompressed_size()
+    // bytes of memory. Data that is stored raw is read in place.
+    bool cache_decoded = false;
+
+    // Build codes from these frequencies rather than the data's own, see
+    // huffman_frequencies.
+    huffman_frequencies frequencies {};
+};
+
+// Options for data that is read often: it stays raw unless compression
+// halves its size, and is otherwise decoded once and read from a cache,
+// with an aligned, cache-line padded tree for that first decode.
+inline constexpr huffman_options huffman_hot {
+    .separate_tree = true,
+    .alignment = 8,
+    .tree_alignment = 64,
+    .min_saved_percent = 50,
+    .cache_decoded = true
+};
+
+// Options for most data: compression must save at least a tenth of the
+// size to be worth decoding.
+inline constexpr huffman_options huffman_balanced {
+    .min_saved_percent = 10
+};
+
+// Options for data that is rarely read: any saving is taken, and nothing is
+// padded or cached.
+inline constexpr huffman_options huffman_cold {};
+
+/**
+ * A compressor's stored bytes and what is needed to decode them, so that
+ * they can be handed as-is to a peer that decodes (e.g. with decode.h, or
+ * any inflater for DEFLATE streams) rather than decoded and re-encoded.
+ */
+struct huffman_encoded {
+    enum encoding_type : unsigned char {
+        identity, // The raw values
+        huffman,  // huffman_compressor's format, described by its layout()
+        deflate,  // A bare DEFLATE stream (RFC 1951)
+        zlib,     // zlib framing (RFC 1950)
+        gzip      // gzip framing (RFC 1952)
+    };
+
+    encoding_type encoding = identity;
+    std::span<const std::byte> bytes;
+    // The decode tree when it is stored apart from bytes, otherwise empty.
+    std::span<const std::byte> tree;
+    unsigned long int uncompressed_size = 0;
+};
+
+/**
+ * Compresses the given data string using Huffman coding, providing a
+ * minimal run-time interface for decompressing the data.
+ * @tparam raw_data The string of data to be compressed.
+ * @tparam options Storage options, see huffman_options.
+ */
+template<auto raw_data, huffman_options options = huffman_options{}>
+    requires(
+        std::same_as<std::remove_cvref_t<decltype(raw_data)>,
+            detail::huffman_string_container<std::remove_cvref_t<decltype(raw_data.data[0])>,
+                raw_data.size()>> &&
+        raw_data.size() > 0)
+class huffman_compressor
+{
+    using size_t = long int;
+    using usize_t = unsigned long int;
+
+    // Note: class internals need to be defined before the public interface.
+    // See the bottom of the class definition for usage.
+private:
+    using node = detail::huffman_node;
+
     /**
-     * Compresses the input data, storing the result in the object instance.
+     * Builds a list of nodes for every character that appears in the given data.
+     * This list is sorted by increasing frequency.
+     * @return Compile-time allocated array of nodes
      */
-    consteval void compress() noexcept {
-        auto tree = build_node_tree();
+    consteval static auto build_node_list() noexcept {
+        size_t freq[256] = {};
+        for (usize_t i = 0; i < raw_data.size(); i++)
+            freq[static_cast<unsigned char>(raw_data[i])]++;
 
-        // Set up byte and bit count (note, we're compressing the data backwards)
-        auto [bytes, bits] = compressed_size_info();
-        if (bits > 0)
-            bits = 8 - bits;
-        else
-            bits = 0, bytes--;
-
-        // Compress data backwards, because we obtain the Huffman codes backwards
-        // as we traverse towards the parent node.
-        for (auto i = raw_data.size(); i > 0; i--) {
-            auto c = static_cast<int>(raw_data[i - 1]);
-            auto leaf = std::find_if(tree.begin(), tree.end(),
-                [c](auto& n) { return n.value == c; });
-
-            while (leaf->parent != -1) {
-                auto parent = tree.begin() + leaf->parent;
-                if (parent->right == leaf->value)
-                    compressed_data[bytes - 1] |= (1 << bits);
-                if (++bits == 8)
-                    bits = 0, --bytes;
-                leaf = parent;
+        // Follow the given frequencies, but keep a code for every value
+        // that occurs in the data
+        if constexpr (!options.frequencies.empty()) {
+            for (int i = 0; i < 256; i++) {
+                auto n = options.frequencies.counts[i];
+                freq[i] = n > 0 ? n : std::min<size_t>(freq[i], 1);
             }
         }
 
+        return detail::huffman_build_node_list(freq);
+    }
+
+    /**
+     * Returns the count of how many nodes are in the node tree.
+     */
+    consteval static auto tree_count() noexcept {
+        auto list = build_node_list();
+        auto count = list.size() * 2 - 1;
+        delete[] list.data();
+        return count;
+    }
+
+    /**
+     * Builds a tree out of the node list, allowing for the calculation of
+     * Huffman codes.
+     * @return Compile-time allocated tree of nodes, root node at index zero.
+     */
+    consteval static auto build_node_tree() noexcept {
+        return detail::huffman_build_node_tree(build_node_list());
+    }
+
+    /**
+     * Finds each byte value's code from the node tree, whether or not the
+     * data ends up stored compressed.
+     */
+    consteval static auto build_codes() noexcept {
+        std::array<code_type, 256> table {};
+        auto tree = build_node_tree();
+        for (auto leaf = tree.end(); leaf-- != tree.begin();) {
+            if (leaf->value > 0xFF)
+                continue;
+            auto& entry = table[leaf->value];
+            for (auto n = leaf; n->parent != -1; n = tree.begin() + n->parent) {
+                if (tree[n->parent].right == n->value)
+                    entry.code |= 1ull << entry.length;
+                entry.length++;
+            }
+        }
         delete[] tree.data();
+        return table;
+    }
+
+    /**
+     * Determines the size of the compressed data.
+     * @return A pair of total bytes used, and bits used in last byte.
+     */
+    consteval static auto compressed_size_info() noexcept {
+        auto codes = build_codes();
+        usize_t code_bits = 0;
+        for (usize_t i = 0; i < raw_data.size(); i++)
+            code_bits += codes[static_cast<unsigned char>(raw_data[i])].length;
+
+        return std::make_pair(static_cast<size_t>(code_bits / 8 + 1),
+            static_cast<size_t>(code_bits % 8));
+    }
+
+    /**
+     * Compresses the input data, storing the result in the object instance.
+     * @param output Where to store the compressed data.
+     * @param reverse If true, store the codes in reverse order (the code of
+     *                the last value first).
+     */
+    consteval void compress(unsigned char *output, bool reverse) noexcept {
+        auto codes = build_codes();
+
+        detail::huffman_bit_writer writer {output};
+        for (usize_t i = 0; i < raw_data.size(); i++) {
+            auto c = static_cast<unsigned char>(
+                raw_data[reverse ? raw_data.size() - 1 - i : i]);
+            writer.put(codes[c].code, codes[c].length);
+        }
     }
 
     /**
@@ -223,42 +505,219 @@ private:
      * Format: three bytes per node.
      *     1. Node value, 2. Distance to left child, 3. Distance to right child.
      */
-    consteval void build_decode_tree() noexcept {
+    consteval static auto build_decode_tree() noexcept {
+        std::array<unsigned char, tree_size()> table {};
         auto tree = build_node_tree();
-        auto decode_tree = compressed_data + compressed_size_info().first;
+        detail::huffman_write_decode_tree(tree, table.data());
+        delete[] tree.data();
+        return table;
+    }
 
-        for (usize_t i = 0; i < tree_count(); i++) {
-            // Only store node value if it represents a data value
-            decode_tree[i * 3] = tree[i].value <= 0xFF ? tree[i].value : 0;
+    /**
+     * Checks that every child distance in the decode tree fits in its byte.
+     * Wide trees, such as those from frequencies that cover most byte
+     * values, may not; the data is then stored uncompressed.
+     */
+    consteval static bool tree_fits() noexcept {
+        auto tree = build_node_tree();
+        auto *table = new unsigned char[3 * tree.size()];
+        bool fits = detail::huffman_write_decode_tree(tree, table);
+        delete[] table;
+        delete[] tree.data();
+        return fits;
+    }
 
-            usize_t j;
-            // Find the left child of this node
-            for (j = i + 1; j < tree_count(); j++) {
-                if (tree[i].left == tree[j].value)
-                    break;
-            }
-            decode_tree[i * 3 + 1] = j < tree_count() ? j - i : 0;
-            // Find the right child of this node
-            for (j = i + 1; j < tree_count(); j++) {
-                if (tree[i].right == tree[j].value)
-                    break;
-            }
-            decode_tree[i * 3 + 2] = j < tree_count() ? j - i : 0;
-        }
+    consteval static usize_t tree_alignment() noexcept {
+        return options.separate_tree ? std::max(64u, options.tree_alignment)
+                                     : options.tree_alignment;
+    }
 
-        delete[] tree.data();
+    // Size of the decode tree, including padding.
+    consteval static usize_t tree_size() noexcept {
+        return detail::huffman_round_up(3 * tree_count(), tree_alignment());
+    }
+
+    // Offset of the decode tree in compressed_data, after the payload.
+    consteval static usize_t tree_offset() noexcept {
+        return detail::huffman_round_up(compressed_size_info().first,
+            tree_alignment());
+    }
+
+    // Offset of the reversed codes in compressed_data.
+    consteval static usize_t reversed_offset() noexcept {
+        return options.separate_tree ? compressed_size_info().first
+                                     : tree_offset() + tree_size();
+    }
+
+    // Size of compressed_data when the data is compressed.
+    consteval static usize_t stored_size() noexcept {
+        return options.bidirectional
+            ? reversed_offset() + compressed_size_info().first
+            : reversed_offset();
+    }
+
+    // Returns the decode tree for the data at comp_data.
+    static const unsigned char *decode_table(const unsigned char *comp_data) noexcept {
+        if constexpr (options.separate_tree && bytes_saved() > 0)
+            return detail::huffman_shared_tree<build_decode_tree(), tree_alignment()>.data();
+        else
+            return comp_data + tree_offset();
+    }
+
+    /**
+     * Writes description()'s text, if out is not null.
+     * @return The length of the text.
+     */
+    consteval static usize_t write_description(char *out) noexcept {
+        detail::huffman_text_writer w {out};
+        auto l = layout();
+        auto part = [&w](const char *name, usize_t offset, usize_t size) {
+            w.put(",\""), w.put(name), w.put("\":{\"offset\":"), w.put(offset);
+            w.put(",\"size\":"), w.put(size), w.put("}");
+        };
+
+        w.put("{\"compressed\":"), w.put(l.compressed ? "true" : "false");
+        w.put(",\"separate_tree\":"), w.put(l.separate_tree ? "true" : "false");
+        w.put(",\"values\":"), w.put(l.values);
+        part("payload", l.payload_offset, l.payload_size);
+        part("tree", l.tree_offset, l.tree_size);
+        part("reversed", l.reversed_offset, l.reversed_size);
+        w.put(",\"codes\":{");
+        bool first = true;
+        auto table = code_table();
+        for (unsigned int i = 0; i < 256; i++) {
+            if (table[i].length == 0)
+                continue;
+            w.put(first ? "\"" : ",\""), w.put(i), w.put("\":\"");
+            for (auto b = table[i].length; b-- > 0;)
+                w.put((table[i].code >> b) & 1 ? "1" : "0");
+            w.put("\"");
+            first = false;
+        }
+        w.put("}}");
+        return w.size;
     }
 
 public:
+    // The type of the uncompressed elements (char or unsigned char).
+    using value_type = std::remove_cvref_t<decltype(raw_data.data[0])>;
+
+    // Returned by find() when the pattern does not occur.
+    constexpr static usize_t npos = static_cast<usize_t>(-1);
+
+    // A separate tree built from given frequencies is shared by all data
+    // using them, so it is not counted here.
     consteval static auto compressed_size() noexcept {
-        return compressed_size_info().first + 3 * tree_count();
+        bool own_tree = options.separate_tree && options.frequencies.empty();
+        return static_cast<size_t>(stored_size() + (own_tree ? tree_size() : 0));
     }
     consteval static auto uncompressed_size() noexcept {
         return raw_data.size();
     }
+    /**
+     * Returns how many bytes compression saves, or zero if the data is
+     * stored uncompressed: either compression does not pay off, it saves
+     * less than options requires, or the decode tree cannot be stored.
+     */
     consteval static size_t bytes_saved() noexcept {
         size_t diff = uncompressed_size() - compressed_size();
-        return diff > 0 ? diff : 0;
+        const auto [size_bytes, last_bits] = compressed_size_info();
+        auto code_bits = (size_bytes - 1) * 8 + last_bits;
+        bool worth = diff > 0 && tree_fits() &&
+            static_cast<usize_t>(diff) >= options.min_saved_bytes &&
+            diff * 100 >= static_cast<size_t>(options.min_saved_percent *
+                uncompressed_size()) &&
+            diff * 100 >= static_cast<size_t>(options.decode_cost) * code_bits;
+        return worth ? diff : 0;
+    }
+
+    // A byte value's code, read most significant bit first.
+    struct code_type {
+        unsigned long long code = 0;
+        unsigned char length = 0; // Zero if the value does not occur
+    };
+
+    /**
+     * Returns each byte value's code, as stored. If the data is stored
+     * uncompressed, every occurring value's code is its own eight bits.
+     */
+    consteval static auto code_table() noexcept {
+        std::array<code_type, 256> table {};
+        if constexpr (bytes_saved() > 0) {
+            table = build_codes();
+        } else {
+            for (usize_t i = 0; i < raw_data.size(); i++) {
+                auto c = static_cast<unsigned char>(raw_data[i]);
+                table[c] = {c, 8};
+            }
+        }
+
+        return table;
+    }
+
+    /**
+     * Returns the length in bits of each byte value's code, as stored.
+     * Values that do not occur in the data have a length of zero. If the
+     * data is stored uncompressed, every occurring value has a length of 8.
+     */
+    consteval static auto code_lengths() noexcept {
+        std::array<unsigned char, 256> lengths {};
+        auto table = code_table();
+        for (int i = 0; i < 256; i++)
+            lengths[i] = table[i].length;
+        return lengths;
+    }
+
+    // Where each part of data() lies, in bytes.
+    struct layout_type {
+        bool compressed = false;   // If false, data() holds the raw values
+        usize_t values = 0;        // Number of values encoded
+        usize_t payload_offset = 0;
+        usize_t payload_size = 0;
+        bool separate_tree = false; // If true, see decode_tree() instead
+        usize_t tree_offset = 0;   // Decode tree, three bytes per node
+        usize_t tree_size = 0;
+        usize_t reversed_offset = 0; // Reversed codes, if bidirectional
+        usize_t reversed_size = 0;
+    };
+
+    /**
+     * Describes the layout of data(), so that decoders outside of C++ can
+     * find the payload and decode tree. The decode tree has three bytes per
+     * node, root first: the node's value, then the distances (in nodes) to
+     * its left (0 bit) and right (1 bit) children. Leaves have a left
+     * distance of zero. Codes are read from each byte's most significant bit.
+     */
+    consteval static auto layout() noexcept {
+        layout_type l;
+        l.values = raw_data.size();
+        if constexpr (bytes_saved() > 0) {
+            l.compressed = true;
+            l.payload_size = compressed_size_info().first;
+            l.separate_tree = options.separate_tree;
+            l.tree_offset = options.separate_tree ? 0 : tree_offset();
+            l.tree_size = 3 * tree_count();
+            if constexpr (options.bidirectional) {
+                l.reversed_offset = reversed_offset();
+                l.reversed_size = l.payload_size;
+            }
+        } else {
+            l.payload_size = raw_data.size();
+        }
+        return l;
+    }
+
+    /**
+     * Returns layout() and code_table() as JSON text, for external tools:
+     *     {"compressed":true,"separate_tree":false,"values":25,
+     *      "payload":{"offset":0,"size":12},"tree":{"offset":12,"size":39},
+     *      "reversed":{"offset":0,"size":0},"codes":{"32":"010",...}}
+     * Codes are given as strings of bits, first bit first.
+     */
+    consteval static auto description() noexcept {
+        std::array<char, write_description(nullptr)> text {};
+        write_description(text.data());
+        return text;
     }
 
     // Utility for decoding compressed data.
@@ -267,14 +726,24 @@ public:
         using difference_type = std::ptrdiff_t;
         using value_type = int;
 
+        // A decoder's location in the data: the bit offset at which the
+        // current element's code begins, and the index of that element.
+        struct position_type {
+            usize_t bit = 0;
+            usize_t index = 0;
+
+            bool operator==(const position_type&) const noexcept = default;
+        };
+
         decoder(const unsigned char *comp_data) noexcept
-            : m_data(comp_data),
-              m_table(comp_data + compressed_size_info().first) { get_next(); }
+            : m_data(comp_data), m_base(comp_data) { get_next(); }
         decoder() = default;
 
         constexpr static decoder end(const unsigned char *comp_data) noexcept {
             decoder ender;
             ender.m_data = comp_data;
+            ender.m_base = comp_data;
+            ender.m_index = raw_data.size();
             if constexpr (bytes_saved() > 0) {
                 const auto [size_bytes, last_bits] = compressed_size_info();
                 ender.m_data += size_bytes - 1;
@@ -286,6 +755,27 @@ public:
             return ender;
         }
 
+        /**
+         * Creates a decoder that resumes decoding at the given position,
+         * as previously returned by position().
+         */
+        static decoder from_position(const unsigned char *comp_data,
+            position_type pos) noexcept
+        {
+            decoder resumed;
+            resumed.m_data = comp_data + pos.bit / 8;
+            resumed.m_base = comp_data;
+            resumed.m_bit = 0x80 >> (pos.bit % 8);
+            resumed.m_index = pos.index;
+            resumed.get_next();
+            return resumed;
+        }
+
+        auto position() const noexcept {
+            usize_t bit = (m_data - m_base) * 8 + 8 - std::bit_width(m_bit);
+            return position_type {bit - m_length, m_index};
+        }
+
         bool operator==(const decoder& other) const noexcept {
             return m_data == other.m_data &&
                 m_bit == other.m_bit &&
@@ -295,55 +785,100 @@ public:
             return m_current;
         }
         decoder& operator++() noexcept {
+            m_index++;
             get_next();
             return *this;
         }
         decoder operator++(int) noexcept {
             auto old = *this;
-            get_next();
+            ++*this;
+            return old;
+        }
+
+        // Steps back to the previous value by decoding the reversed codes.
+        decoder& operator--() noexcept
+            requires (options.bidirectional)
+        {
+            auto pos = position();
+            auto base = m_base;
+            if constexpr (bytes_saved() > 0) {
+                const auto [size_bytes, last_bits] = compressed_size_info();
+                auto rbit = (size_bytes - 1) * 8 + last_bits - pos.bit;
+                auto *rdata = base + reversed_offset() + rbit / 8;
+                unsigned char rmask = 0x80 >> (rbit % 8);
+                m_current = decode_one(rdata, rmask, m_length);
+            } else {
+                m_current = base[pos.bit / 8 - 1];
+                m_length = 8;
+            }
+
+            m_data = base + pos.bit / 8;
+            m_bit = 0x80 >> (pos.bit % 8);
+            m_index = pos.index - 1;
+            return *this;
+        }
+        decoder operator--(int) noexcept
+            requires (options.bidirectional)
+        {
+            auto old = *this;
+            --*this;
             return old;
         }
 
     private:
+        /**
+         * Decodes one value by walking the decode tree.
+         * @param data Byte to read from, advanced past the value's code.
+         * @param bit Bit mask to read from, advanced past the value's code.
+         * @param length Set to the length of the value's code, in bits.
+         */
+        int decode_one(const unsigned char *& data, unsigned char& bit,
+            unsigned char& length) const noexcept
+        {
+            return detail::huffman_decode_one(decode_table(m_base), data, bit,
+                length);
+        }
+
         void get_next() noexcept {
-            if (auto e = end(m_table - compressed_size_info().first);
+            if (auto e = end(m_base);
                 m_data == e.m_data && m_bit == e.m_bit)
             {
                 m_current = -1;
+                m_length = 0;
                 return;
             }
             if constexpr (bytes_saved() > 0) {
-                auto *node = m_table;
-                int data = *m_data;
-                auto bit = m_bit;
-                do {
-                    node += (data & bit) ? node[2] * 3u : node[1] * 3u;
-                    bit >>= 1;
-                    if (!bit)
-                        bit = 0x80, data = *++m_data;
-                } while (node[1] != 0);
-                m_bit = bit;
-                m_current = *node;
+                m_current = decode_one(m_data, m_bit, m_length);
             } else {
                 m_current = *m_data++;
+                m_length = 8;
             }
         }
 
         const unsigned char *m_data = nullptr;
-        const unsigned char *m_table = nullptr;
+        const unsigned char *m_base = nullptr; // Start of the data
         unsigned char m_bit = 0x80;
+        unsigned char m_length = 0; // Bits in the current element's code
         int m_current = -1;
+        usize_t m_index = 0;
 
         friend class huffman_compressor;
     };
 
-    // Stick the forward_iterator check here just so it's run
+    // Stick the iterator checks here just so they're run
     consteval huffman_compressor() noexcept
-        requires (std::forward_iterator<decoder>)
+        requires (std::forward_iterator<decoder> &&
+            (!options.bidirectional || std::bidirectional_iterator<decoder>))
     {
         if constexpr (bytes_saved() > 0) {
-            build_decode_tree();
-            compress();
+            if constexpr (!options.separate_tree) {
+                auto table = build_decode_tree();
+                std::copy(table.begin(), table.end(),
+                    compressed_data + tree_offset());
+            }
+            compress(compressed_data, false);
+            if constexpr (options.bidirectional)
+                compress(compressed_data + reversed_offset(), true);
         } else {
             std::copy(raw_data.data, raw_data.data + raw_data.size(),
                 compressed_data);
@@ -351,34 +886,148 @@ public:
     }
 
     auto begin() const noexcept {
-        return decoder(compressed_data);
+        if constexpr (options.cache_decoded && bytes_saved() > 0)
+            return decoded().begin();
+        else
+            return decoder(compressed_data);
     }
     auto end() const noexcept {
-        return decoder::end(compressed_data);
+        if constexpr (options.cache_decoded && bytes_saved() > 0)
+            return decoded().end();
+        else
+            return decoder::end(compressed_data);
     }
     auto cbegin() const noexcept { return begin(); }
     auto cend() const noexcept { return end(); }
 
-    // For accessing the compressed data
+    /**
+     * Searches the data for the given pattern, decoding it one value at a
+     * time (Knuth-Morris-Pratt) so the full output is never stored.
+     * @return Index of the pattern's first occurrence, or npos.
+     */
+    usize_t find(std::string_view pattern) const {
+        if (pattern.empty())
+            return 0;
+
+        // Length of the longest proper prefix of pattern[0..i] that is also
+        // a suffix of it.
+        auto fail = std::make_unique<usize_t[]>(pattern.size());
+        for (usize_t i = 1, k = 0; i < pattern.size(); i++) {
+            while (k > 0 && pattern[i] != pattern[k])
+                k = fail[k - 1];
+            if (pattern[i] == pattern[k])
+                k++;
+            fail[i] = k;
+        }
+
+        usize_t index = 0, matched = 0;
+        for (auto it = begin(), e = end(); it != e; ++it, ++index) {
+            auto c = static_cast<unsigned char>(*it);
+            while (matched > 0 && c != static_cast<unsigned char>(pattern[matched]))
+                matched = fail[matched - 1];
+            if (c == static_cast<unsigned char>(pattern[matched]) &&
+                ++matched == pattern.size())
+            {
+                return index + 1 - matched;
+            }
+        }
+
+        return npos;
+    }
+    bool contains(std::string_view pattern) const {
+        return find(pattern) != npos;
+    }
+
+    // Resumes decoding at a position saved from decoder::position().
+    auto at(typename decoder::position_type pos) const noexcept {
+        return decoder::from_position(compressed_data, pos);
+    }
+
+    // For accessing the compressed data, or the raw values if they were
+    // stored uncompressed
     auto data() const noexcept {
-        if constexpr (bytes_saved() > 0)
-            return compressed_data;
-        else
-            return raw_data;
+        return compressed_data;
+    }
+
+    /**
+     * Returns data() and its encoding without decoding anything, for passing
+     * the stored bytes on to another decoder. Pair with description() or
+     * layout() to tell a peer where the payload and tree lie.
+     */
+    huffman_encoded encoded() const noexcept {
+        huffman_encoded e;
+        e.bytes = std::as_bytes(std::span(compressed_data, size()));
+        e.uncompressed_size = uncompressed_size();
+        if constexpr (bytes_saved() > 0) {
+            e.encoding = huffman_encoded::huffman;
+            if constexpr (options.separate_tree)
+                e.tree = std::as_bytes(std::span(decode_tree(), 3 * tree_count()));
+        }
+        return e;
+    }
+
+    // Returns the decode tree, which is part of data() unless
+    // options.separate_tree is set. Not valid for uncompressed data.
+    auto decode_tree() const noexcept {
+        return decode_table(compressed_data);
     }
 
     auto size() const noexcept {
         if constexpr (bytes_saved() > 0)
-            return compressed_size();
+            return stored_size();
         else
             return uncompressed_size();
     }
 
+    /**
+     * Returns a view of the fully decompressed data.
+     * The data is decompressed once, on first use, into static storage that
+     * is shared by every instance of this literal. Any number of threads may
+     * call this concurrently: the first caller decompresses while the others
+     * wait on the cache's state flag, and all later calls are a single
+     * acquire load.
+     */
+    auto decoded() const noexcept {
+        auto state = decoded_cache.state.load(std::memory_order_acquire);
+        if (state != cache_ready) {
+            state = cache_empty;
+            if (decoded_cache.state.compare_exchange_strong(state, cache_busy,
+                std::memory_order_acquire))
+            {
+                std::copy(decoder(compressed_data),
+                    decoder::end(compressed_data), decoded_cache.data);
+                decoded_cache.state.store(cache_ready, std::memory_order_release);
+                decoded_cache.state.notify_all();
+            } else {
+                while (state != cache_ready) {
+                    decoded_cache.state.wait(state, std::memory_order_acquire);
+                    state = decoded_cache.state.load(std::memory_order_acquire);
+                }
+            }
+        }
+
+        return std::span<const value_type, uncompressed_size()>(
+            decoded_cache.data, uncompressed_size());
+    }
+
 private:
-    // Contains the compressed data, followed by the decoding tree.
-    unsigned char compressed_data[
-        bytes_saved() > 0 ? compressed_size_info().first + 3 * tree_count()
-                          : raw_data.size()] = {0};
+    enum : unsigned char { cache_empty, cache_busy, cache_ready };
+
+    // Storage for decoded(). Each literal gets its own cache, aligned to a
+    // cache line so that initializing one cache never invalidates another.
+    struct alignas(64) cache {
+        std::atomic<unsigned char> state = cache_empty;
+        value_type data[raw_data.size()];
+    };
+    inline static cache decoded_cache;
+
+    // Contains the compressed data, followed by the decoding tree (unless
+    // options.separate_tree is set), followed by the reversed codes if
+    // options.bidirectional is set.
+    alignas(options.separate_tree ? options.alignment
+        : std::max(options.alignment, options.tree_alignment))
+    unsigned char compressed_data[bytes_saved() > 0 ? stored_size()
+        : raw_data.size()] = {0};
 };
 
 template <detail::huffman_string_container hsc>
@@ -387,8 +1036,147 @@ constexpr auto operator ""_huffman()
     return huffman_compressor<hsc>();
 }
 
-template <detail::huffman_string_container hsc>
-constexpr auto huffman_compress = huffman_compressor<hsc>();
+template <detail::huffman_string_container hsc, huffman_options options = huffman_options{}>
+constexpr auto huffman_compress = huffman_compressor<hsc, options>();
+
+namespace detail
+{
+    // Returns how many bytes a huffman_compressor actually stores, which is
+    // the uncompressed size when compression did not pay off.
+    template<typename compressor>
+    consteval auto huffman_stored_size() noexcept {
+        return compressor::bytes_saved() > 0
+            ? static_cast<unsigned long int>(compressor::compressed_size())
+            : static_cast<unsigned long int>(compressor::uncompressed_size());
+    }
+
+    // Splits integers into their bytes, lowest first, either element by
+    // element or as byte planes (every lowest byte, then every second byte...).
+    template <bool planar, typename T, T... list>
+    class huffman_byte_split_container {
+    private:
+        consteval static auto split() noexcept {
+            constexpr T values[] = {list...};
+            constexpr auto n = sizeof...(list);
+            unsigned char bytes[n * sizeof(T)] = {};
+            for (unsigned long int i = 0; i < n; i++) {
+                auto v = static_cast<std::make_unsigned_t<T>>(values[i]);
+                for (unsigned long int b = 0; b < sizeof(T); b++) {
+                    bytes[planar ? b * n + i : i * sizeof(T) + b] =
+                        static_cast<unsigned char>(v >> (b * 8));
+                }
+            }
+            return huffman_string_container(bytes);
+        }
+    public:
+        constexpr static auto data = split();
+    };
+}
+
+/**
+ * Compresses an array of multi-byte integers. Each integer is split into its
+ * bytes, lowest first, so the compressed data does not depend on the target's
+ * byte order. Decompression yields whole integers of type T.
+ * @tparam T The integer type. Single-byte types are accepted too, for an
+ *           iterator that yields T rather than int.
+ * @tparam list The integers to compress.
+ */
+template <typename T, T... list>
+    requires(std::integral<T> && !std::same_as<T, bool> && sizeof...(list) > 0)
+class huffman_wide_compressor
+{
+    using usize_t = unsigned long int;
+
+    constexpr static usize_t count = sizeof...(list);
+
+public:
+    using value_type = T;
+    using compressor = huffman_compressor<
+        detail::huffman_byte_split_container<false, T, list...>::data>;
+
+    // Iterates over the integers, decoding sizeof(T) bytes per step.
+    class decoder {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        decoder() = default;
+        decoder(typename compressor::decoder next, usize_t remaining) noexcept
+            : m_next(next), m_remaining(remaining) { get_next(); }
+
+        bool operator==(const decoder& other) const noexcept {
+            return m_remaining == other.m_remaining;
+        }
+        auto operator*() const noexcept {
+            return m_current;
+        }
+        decoder& operator++() noexcept {
+            m_remaining--;
+            get_next();
+            return *this;
+        }
+        decoder operator++(int) noexcept {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+    private:
+        void get_next() noexcept {
+            if (m_remaining == 0)
+                return;
+
+            std::make_unsigned_t<T> v = 0;
+            for (usize_t b = 0; b < sizeof(T); b++, ++m_next)
+                v |= static_cast<std::make_unsigned_t<T>>(*m_next) << (b * 8);
+            m_current = static_cast<T>(v);
+        }
+
+        typename compressor::decoder m_next;
+        usize_t m_remaining = 0;
+        T m_current = 0;
+    };
+
+    consteval huffman_wide_compressor() noexcept = default;
+
+    consteval static auto compressed_size() noexcept {
+        return detail::huffman_stored_size<compressor>();
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return count * sizeof(T);
+    }
+
+    // Returns the number of integers.
+    constexpr static auto size() noexcept {
+        return count;
+    }
+
+    auto begin() const noexcept {
+        return decoder(data.begin(), count);
+    }
+    auto end() const noexcept {
+        return decoder();
+    }
+    auto cbegin() const noexcept { return begin(); }
+    auto cend() const noexcept { return end(); }
+
+    /**
+     * Decompresses all of the integers.
+     * @param out Where to store the integers; must hold size().
+     */
+    void decode(std::span<T> out) const noexcept {
+        auto it = data.begin();
+        for (auto& v : out) {
+            std::make_unsigned_t<T> u = 0;
+            for (usize_t b = 0; b < sizeof(T); b++, ++it)
+                u |= static_cast<std::make_unsigned_t<T>>(*it) << (b * 8);
+            v = static_cast<T>(u);
+        }
+    }
+
+    // The compressed bytes of the integers.
+    compressor data;
+};
 
 namespace detail
 {
@@ -399,6 +1187,13 @@ namespace detail
     public:
         constexpr static auto data = huffman_compress<uncompressed>;
     };
+
+    template <typename T, T... list>
+        requires(sizeof(T) > 1)
+    class huffman_compress_array_container<T, list...> {
+    public:
+        constexpr static auto data = huffman_wide_compressor<T, list...>();
+    };
 }
 template <typename T, T... list>
 constexpr auto huffman_compress_array = detail::huffman_compress_array_container<T, list...>::data;
@@ -0,0 +1,62 @@
+/**
+ * decode.h - Portable C99 decoder for huffman_compressor's data.
+ * https://github.com/tcsullivan/consteval-huffman
+ *
+ * Export a compressor's data() along with its layout() (or description()),
+ * then decode it here without C++. Data that was stored uncompressed
+ * (layout().compressed is false) holds the raw values and needs no decoding.
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_DECODE_H_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_DECODE_H_
+
+#include <stddef.h>
+
+/* Reads values one at a time from a payload. */
+struct huffman_reader {
+    const unsigned char *data;
+    const unsigned char *tree;
+    unsigned char bit;
+};
+
+/**
+ * Prepares to read from the start of a payload.
+ * @param payload The payload: data() + layout().payload_offset.
+ * @param tree The decode tree: data() + layout().tree_offset.
+ */
+static inline void huffman_reader_init(struct huffman_reader *reader,
+    const unsigned char *payload, const unsigned char *tree)
+{
+    reader->data = payload;
+    reader->tree = tree;
+    reader->bit = 0x80;
+}
+
+/* Decodes the next value. Read no more than layout().values values. */
+static inline unsigned char huffman_reader_next(struct huffman_reader *reader)
+{
+    const unsigned char *node = reader->tree;
+    do {
+        node += 3u * ((*reader->data & reader->bit) ? node[2] : node[1]);
+        reader->bit >>= 1;
+        if (!reader->bit) {
+            reader->bit = 0x80;
+            reader->data++;
+        }
+    } while (node[1] != 0);
+    return node[0];
+}
+
+/* Decodes count values from the payload into out. */
+static inline void huffman_decode(const unsigned char *payload,
+    const unsigned char *tree, size_t count, unsigned char *out)
+{
+    struct huffman_reader reader;
+    size_t i;
+
+    huffman_reader_init(&reader, payload, tree);
+    for (i = 0; i < count; i++)
+        out[i] = huffman_reader_next(&reader);
+}
+
+#endif /* TCSULLIVAN_CONSTEVAL_HUFFMAN_DECODE_H_ */
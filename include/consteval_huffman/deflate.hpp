@@ -0,0 +1,601 @@
+/**
+ * deflate.hpp - Compile-time DEFLATE, zlib and gzip streams.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_DEFLATE_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_DEFLATE_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace detail
+{
+    // Tables from RFC 1951: the base value and extra bit count of each
+    // length code (257-285) and distance code (0-29).
+    inline constexpr std::uint16_t huffman_deflate_length_base[29] = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+    };
+    inline constexpr unsigned char huffman_deflate_length_extra[29] = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+    };
+    inline constexpr std::uint16_t huffman_deflate_distance_base[30] = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193,
+        12289, 16385, 24577
+    };
+    inline constexpr unsigned char huffman_deflate_distance_extra[30] = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+    };
+    // Order in which code length code lengths are stored.
+    inline constexpr unsigned char huffman_deflate_code_length_order[19] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+    };
+
+    // Table for CRC-32 as used by gzip (reflected, polynomial 0xEDB88320).
+    inline constexpr auto huffman_crc32_table = [] {
+        std::array<std::uint32_t, 256> table {};
+        for (std::uint32_t i = 0; i < 256; i++) {
+            auto crc = i;
+            for (int b = 0; b < 8; b++)
+                crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+            table[i] = crc;
+        }
+        return table;
+    }();
+
+    constexpr std::uint32_t huffman_crc32(const unsigned char *data,
+        unsigned long int size, std::uint32_t crc = 0) noexcept
+    {
+        crc = ~crc;
+        for (unsigned long int i = 0; i < size; i++)
+            crc = huffman_crc32_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    // Adler-32 as used by zlib. The sums are reduced every 5552 bytes, the
+    // most that can be added without overflowing.
+    constexpr std::uint32_t huffman_adler32(const unsigned char *data,
+        unsigned long int size) noexcept
+    {
+        std::uint32_t a = 1, b = 0;
+        for (unsigned long int i = 0; i < size;) {
+            for (auto end = std::min(size, i + 5552); i < end; i++) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        return (b << 16) | a;
+    }
+
+    /**
+     * Finds Huffman code lengths no longer than limit. Frequencies are
+     * halved (keeping every occurring value) until the tree is shallow
+     * enough. A lone value is given a length of one.
+     */
+    constexpr void huffman_limited_lengths(const long int *freq, int count,
+        unsigned int limit, unsigned char *lengths) noexcept
+    {
+        auto scaled = new long int[count];
+        std::copy(freq, freq + count, scaled);
+
+        while (1) {
+            auto tree = huffman_build_node_tree(huffman_build_node_list(scaled, count));
+            unsigned int max = 0;
+            std::fill(lengths, lengths + count, 0);
+            for (auto leaf = tree.begin(); leaf != tree.end(); ++leaf) {
+                if (leaf->value >= count || scaled[leaf->value] == 0)
+                    continue;
+                unsigned int length = 0;
+                for (auto n = leaf; n->parent != -1; n = tree.begin() + n->parent)
+                    length++;
+                lengths[leaf->value] = static_cast<unsigned char>(std::max(length, 1u));
+                max = std::max(max, length);
+            }
+            delete[] tree.data();
+
+            if (max <= limit)
+                break;
+            for (int i = 0; i < count; i++) {
+                if (scaled[i] != 0)
+                    scaled[i] = (scaled[i] + 1) / 2;
+            }
+        }
+
+        delete[] scaled;
+    }
+
+    /**
+     * Assigns canonical codes for the given lengths (RFC 1951, 3.2.2).
+     * Codes are stored bit-reversed, ready to be written least significant
+     * bit first.
+     */
+    constexpr void huffman_canonical_codes(const unsigned char *lengths,
+        int count, std::uint16_t *codes) noexcept
+    {
+        unsigned int length_count[16] = {};
+        for (int i = 0; i < count; i++)
+            length_count[lengths[i]]++;
+        length_count[0] = 0;
+
+        unsigned int next[16] = {};
+        for (int bits = 1, code = 0; bits < 16; bits++) {
+            code = (code + length_count[bits - 1]) << 1;
+            next[bits] = code;
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (lengths[i] == 0)
+                continue;
+            unsigned int code = next[lengths[i]]++, reversed = 0;
+            for (int b = 0; b < lengths[i]; b++)
+                reversed |= ((code >> b) & 1) << (lengths[i] - 1 - b);
+            codes[i] = static_cast<std::uint16_t>(reversed);
+        }
+    }
+
+    // Writes bits least significant first, as DEFLATE requires. With a null
+    // buffer, only counts the bits.
+    struct huffman_deflate_bit_writer {
+        unsigned char *data = nullptr;
+        unsigned long int bits = 0;
+
+        constexpr void put(unsigned long int value, unsigned int count) noexcept {
+            for (unsigned int i = 0; i < count; i++, bits++) {
+                if (data && ((value >> i) & 1))
+                    data[bits / 8] |= static_cast<unsigned char>(1 << (bits % 8));
+            }
+        }
+        constexpr void align() noexcept {
+            bits = (bits + 7) / 8 * 8;
+        }
+        constexpr void put_byte(unsigned char byte) noexcept {
+            align();
+            if (data)
+                data[bits / 8] = byte;
+            bits += 8;
+        }
+    };
+
+    // A literal (length == 0) or a back-reference.
+    struct huffman_lz77_token {
+        std::uint16_t length = 0;
+        std::uint16_t value = 0; // The literal, or the match distance
+    };
+
+    /**
+     * Splits data into literals and back-references using greedy matching
+     * over hash chains.
+     * @return The number of tokens written.
+     */
+    constexpr unsigned long int huffman_lz77(const unsigned char *in,
+        unsigned long int size, huffman_lz77_token *out, bool matches) noexcept
+    {
+        constexpr long int window = 32768, max_length = 258, max_chain = 64;
+        auto head = new long int[4096];
+        auto prev = new long int[window];
+        std::fill(head, head + 4096, -1);
+        std::fill(prev, prev + window, -1);
+
+        auto hash = [in](long int i) {
+            return ((in[i] << 8) ^ (in[i + 1] << 4) ^ in[i + 2]) & 4095;
+        };
+        auto insert = [&](long int i) {
+            if (i + 3 <= static_cast<long int>(size)) {
+                auto h = hash(i);
+                prev[i % window] = head[h];
+                head[h] = i;
+            }
+        };
+
+        unsigned long int count = 0;
+        for (long int i = 0, n = size; i < n;) {
+            long int best_length = 0, best_distance = 0;
+            if (matches && i + 3 <= n) {
+                auto limit = std::min(max_length, n - i);
+                auto candidate = head[hash(i)];
+                for (int chain = max_chain; candidate >= 0 && i - candidate <= window &&
+                    chain > 0; chain--)
+                {
+                    long int length = 0;
+                    while (length < limit && in[candidate + length] == in[i + length])
+                        length++;
+                    if (length > best_length) {
+                        best_length = length;
+                        best_distance = i - candidate;
+                        if (length == limit)
+                            break;
+                    }
+                    auto next = prev[candidate % window];
+                    if (next >= candidate)
+                        break;
+                    candidate = next;
+                }
+            }
+
+            if (best_length >= 3) {
+                out[count++] = {static_cast<std::uint16_t>(best_length),
+                    static_cast<std::uint16_t>(best_distance)};
+                for (auto end = i + best_length; i < end; i++)
+                    insert(i);
+            } else {
+                out[count++] = {0, in[i]};
+                insert(i++);
+            }
+        }
+
+        delete[] head;
+        delete[] prev;
+        return count;
+    }
+
+    // Returns the index of the length or distance code covering value.
+    template<int N>
+    constexpr int huffman_deflate_code_of(const std::uint16_t (&base)[N],
+        unsigned int value) noexcept
+    {
+        int code = N - 1;
+        while (base[code] > value)
+            code--;
+        return code;
+    }
+}
+
+/**
+ * Options for huffman_deflate_compressor.
+ */
+struct huffman_deflate_options {
+    enum format_type : unsigned char {
+        raw,  // A bare DEFLATE stream (RFC 1951)
+        zlib, // zlib framing (RFC 1950), i.e. HTTP's "deflate"
+        gzip  // gzip framing (RFC 1952)
+    };
+
+    format_type format = gzip;
+    // Replace repeated strings with back-references (LZ77). Without this,
+    // only Huffman coding is used.
+    bool lz77 = true;
+};
+
+/**
+ * Compresses the given data into a standard DEFLATE stream at compile-time,
+ * so that it can be sent or stored as-is (e.g. as an HTTP response with
+ * Content-Encoding: gzip) and read by any inflater.
+ * The data is written as a single block: dynamic Huffman (with code lengths
+ * limited to 15 bits), fixed Huffman, or stored, whichever is smallest.
+ * A text literal's terminating null is not included.
+ * @tparam raw_data The data to be compressed.
+ * @tparam options Stream format, see huffman_deflate_options.
+ */
+template<auto raw_data, huffman_deflate_options options = huffman_deflate_options{}>
+    requires(raw_data.size() > 0)
+class huffman_deflate_compressor
+{
+    using usize_t = unsigned long int;
+
+public:
+    using value_type = std::remove_cvref_t<decltype(raw_data.data[0])>;
+
+private:
+    consteval static usize_t input_size() noexcept {
+        auto n = raw_data.size();
+        if (std::same_as<value_type, char> && raw_data.data[n - 1] == '\0')
+            n--;
+        return n;
+    }
+
+    constexpr static usize_t header_size =
+        options.format == huffman_deflate_options::gzip ? 10 :
+        options.format == huffman_deflate_options::zlib ? 2 : 0;
+    constexpr static usize_t trailer_size =
+        options.format == huffman_deflate_options::gzip ? 8 :
+        options.format == huffman_deflate_options::zlib ? 4 : 0;
+
+    // Stored blocks hold at most 65535 bytes, with five bytes of overhead.
+    constexpr static usize_t stored_blocks = input_size() / 65535 + 1;
+    constexpr static usize_t max_size = header_size + input_size() +
+        stored_blocks * 5 + trailer_size;
+
+    enum block_type { stored_block, fixed_block, dynamic_block };
+
+    // Everything needed to write the single block.
+    struct block_plan {
+        const unsigned char *in;
+        const detail::huffman_lz77_token *tokens;
+        usize_t token_count;
+        unsigned char lit_lengths[288];
+        unsigned char dist_lengths[30];
+        unsigned char cl_lengths[19];
+        unsigned char cl_symbols[286 + 30]; // Run-length coded code lengths
+        unsigned char cl_extra[286 + 30];
+        usize_t cl_count;
+        int hlit, hdist, hclen;
+    };
+
+    consteval static void fixed_lengths(block_plan& plan) noexcept {
+        for (int i = 0; i < 288; i++)
+            plan.lit_lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        std::fill(plan.dist_lengths, plan.dist_lengths + 30, 5);
+    }
+
+    consteval static void dynamic_lengths(block_plan& plan) noexcept {
+        long int lit_freq[286] = {}, dist_freq[30] = {};
+        for (usize_t i = 0; i < plan.token_count; i++) {
+            auto t = plan.tokens[i];
+            if (t.length == 0) {
+                lit_freq[t.value]++;
+            } else {
+                lit_freq[257 + detail::huffman_deflate_code_of(
+                    detail::huffman_deflate_length_base, t.length)]++;
+                dist_freq[detail::huffman_deflate_code_of(
+                    detail::huffman_deflate_distance_base, t.value)]++;
+            }
+        }
+        lit_freq[256] = 1;
+
+        detail::huffman_limited_lengths(lit_freq, 286, 15, plan.lit_lengths);
+        if (std::count(dist_freq, dist_freq + 30, 0) == 30)
+            dist_freq[0] = 1; // At least one distance code must be given
+        detail::huffman_limited_lengths(dist_freq, 30, 15, plan.dist_lengths);
+
+        plan.hlit = 286;
+        while (plan.lit_lengths[plan.hlit - 1] == 0)
+            plan.hlit--;
+        plan.hdist = 30;
+        while (plan.dist_lengths[plan.hdist - 1] == 0)
+            plan.hdist--;
+
+        // Run-length code the lengths as one sequence.
+        unsigned char all[286 + 30] = {};
+        std::copy(plan.lit_lengths, plan.lit_lengths + plan.hlit, all);
+        std::copy(plan.dist_lengths, plan.dist_lengths + plan.hdist, all + plan.hlit);
+        usize_t total = plan.hlit + plan.hdist;
+        long int cl_freq[19] = {};
+        plan.cl_count = 0;
+        for (usize_t i = 0; i < total;) {
+            usize_t run = 1;
+            while (i + run < total && all[i + run] == all[i])
+                run++;
+
+            auto emit = [&](unsigned char symbol, unsigned char extra) {
+                plan.cl_symbols[plan.cl_count] = symbol;
+                plan.cl_extra[plan.cl_count++] = extra;
+                cl_freq[symbol]++;
+            };
+            if (all[i] == 0 && run >= 11) {
+                run = std::min<usize_t>(run, 138);
+                emit(18, static_cast<unsigned char>(run - 11));
+            } else if (all[i] == 0 && run >= 3) {
+                emit(17, static_cast<unsigned char>(std::min<usize_t>(run, 10) - 3));
+                run = std::min<usize_t>(run, 10);
+            } else if (all[i] != 0 && run >= 4) {
+                emit(all[i], 0);
+                run = std::min<usize_t>(run - 1, 6);
+                emit(16, static_cast<unsigned char>(run - 3));
+                run++;
+            } else {
+                emit(all[i], 0);
+                run = 1;
+            }
+            i += run;
+        }
+
+        // The code length code must be complete, so a lone symbol is
+        // paired with an unused one.
+        if (std::count(cl_freq, cl_freq + 19, 0) == 18)
+            cl_freq[cl_freq[0] == 0 ? 0 : 1] = 1;
+        detail::huffman_limited_lengths(cl_freq, 19, 7, plan.cl_lengths);
+        plan.hclen = 19;
+        while (plan.hclen > 4 &&
+            plan.cl_lengths[detail::huffman_deflate_code_length_order[plan.hclen - 1]] == 0)
+        {
+            plan.hclen--;
+        }
+    }
+
+    consteval static void write_block(const block_plan& plan, block_type type,
+        detail::huffman_deflate_bit_writer& w) noexcept
+    {
+        auto n = input_size();
+        if (type == stored_block) {
+            for (usize_t offset = 0, block = 0; block < stored_blocks; block++) {
+                auto length = std::min<usize_t>(n - offset, 65535);
+                w.put(block + 1 == stored_blocks ? 1 : 0, 1);
+                w.put(0, 2);
+                w.align();
+                w.put(length, 16);
+                w.put(~length & 0xFFFF, 16);
+                for (usize_t i = 0; i < length; i++)
+                    w.put_byte(plan.in[offset + i]);
+                offset += length;
+            }
+            return;
+        }
+
+        w.put(1, 1);
+        w.put(type == fixed_block ? 1 : 2, 2);
+        if (type == dynamic_block) {
+            w.put(plan.hlit - 257, 5);
+            w.put(plan.hdist - 1, 5);
+            w.put(plan.hclen - 4, 4);
+            for (int i = 0; i < plan.hclen; i++)
+                w.put(plan.cl_lengths[detail::huffman_deflate_code_length_order[i]], 3);
+
+            std::uint16_t cl_codes[19] = {};
+            detail::huffman_canonical_codes(plan.cl_lengths, 19, cl_codes);
+            for (usize_t i = 0; i < plan.cl_count; i++) {
+                auto s = plan.cl_symbols[i];
+                w.put(cl_codes[s], plan.cl_lengths[s]);
+                if (s >= 16)
+                    w.put(plan.cl_extra[i], s == 16 ? 2 : s == 17 ? 3 : 7);
+            }
+        }
+
+        std::uint16_t lit_codes[288] = {}, dist_codes[30] = {};
+        detail::huffman_canonical_codes(plan.lit_lengths, 288, lit_codes);
+        detail::huffman_canonical_codes(plan.dist_lengths, 30, dist_codes);
+        for (usize_t i = 0; i < plan.token_count; i++) {
+            auto t = plan.tokens[i];
+            if (t.length == 0) {
+                w.put(lit_codes[t.value], plan.lit_lengths[t.value]);
+                continue;
+            }
+
+            auto lc = detail::huffman_deflate_code_of(
+                detail::huffman_deflate_length_base, t.length);
+            w.put(lit_codes[257 + lc], plan.lit_lengths[257 + lc]);
+            w.put(t.length - detail::huffman_deflate_length_base[lc],
+                detail::huffman_deflate_length_extra[lc]);
+            auto dc = detail::huffman_deflate_code_of(
+                detail::huffman_deflate_distance_base, t.value);
+            w.put(dist_codes[dc], plan.dist_lengths[dc]);
+            w.put(t.value - detail::huffman_deflate_distance_base[dc],
+                detail::huffman_deflate_distance_extra[dc]);
+        }
+        w.put(lit_codes[256], plan.lit_lengths[256]);
+    }
+
+    struct deflate_result {
+        std::array<unsigned char, max_size> data {};
+        usize_t size = 0;
+    };
+
+    consteval static auto encode() noexcept {
+        auto n = input_size();
+        auto in = new unsigned char[n];
+        for (usize_t i = 0; i < n; i++)
+            in[i] = static_cast<unsigned char>(raw_data.data[i]);
+        auto tokens = new detail::huffman_lz77_token[n];
+        auto literals = new detail::huffman_lz77_token[n];
+
+        // Fixed and dynamic blocks, with and without matches: literal-only
+        // coding can beat LZ77 on short or noisy data.
+        usize_t token_counts[2] = {
+            detail::huffman_lz77(in, n, tokens, options.lz77),
+            detail::huffman_lz77(in, n, literals, false)
+        };
+        block_plan plans[4] {};
+        int plan_count = options.lz77 ? 4 : 2;
+        for (int p = 0; p < plan_count; p++) {
+            plans[p].in = in;
+            plans[p].tokens = p < 2 ? tokens : literals;
+            plans[p].token_count = token_counts[p / 2];
+            if (p % 2 == 0)
+                fixed_lengths(plans[p]);
+            else
+                dynamic_lengths(plans[p]);
+        }
+
+        // Measure each kind of block, then write the smallest.
+        detail::huffman_deflate_bit_writer counter;
+        write_block(plans[0], stored_block, counter);
+        block_type type = stored_block;
+        const block_plan *plan = plans;
+        auto best = counter.bits;
+        for (int p = 0; p < plan_count; p++) {
+            auto t = p % 2 == 0 ? fixed_block : dynamic_block;
+            counter = {};
+            write_block(plans[p], t, counter);
+            if (counter.bits < best)
+                type = t, plan = plans + p, best = counter.bits;
+        }
+
+        deflate_result result;
+        auto *out = result.data.data();
+        if constexpr (options.format == huffman_deflate_options::gzip) {
+            constexpr unsigned char header[10] = {
+                0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF
+            };
+            std::copy(header, header + 10, out);
+        } else if constexpr (options.format == huffman_deflate_options::zlib) {
+            out[0] = 0x78;
+            out[1] = 0x01;
+        }
+
+        detail::huffman_deflate_bit_writer w {out + header_size};
+        write_block(*plan, type, w);
+        result.size = header_size + (w.bits + 7) / 8;
+
+        auto put32 = [&](std::uint32_t value, bool big_endian) {
+            for (int i = 0; i < 4; i++)
+                out[result.size++] = static_cast<unsigned char>(
+                    value >> (big_endian ? 24 - i * 8 : i * 8));
+        };
+        if constexpr (options.format == huffman_deflate_options::gzip) {
+            put32(detail::huffman_crc32(in, n), false);
+            put32(static_cast<std::uint32_t>(n), false);
+        } else if constexpr (options.format == huffman_deflate_options::zlib) {
+            put32(detail::huffman_adler32(in, n), true);
+        }
+
+        delete[] literals;
+        delete[] tokens;
+        delete[] in;
+        return result;
+    }
+
+    constexpr static auto result = encode();
+
+public:
+    consteval huffman_deflate_compressor() noexcept {
+        std::copy(result.data.begin(), result.data.begin() + result.size,
+            compressed_data);
+    }
+
+    consteval static auto compressed_size() noexcept {
+        return result.size;
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return input_size();
+    }
+
+    // Returns the CRC-32 of the uncompressed data, as stored by gzip.
+    consteval static std::uint32_t crc32() noexcept {
+        std::uint32_t crc = 0;
+        for (usize_t i = 0; i < input_size(); i++) {
+            auto c = static_cast<unsigned char>(raw_data.data[i]);
+            crc = detail::huffman_crc32(&c, 1, crc);
+        }
+        return crc;
+    }
+
+    // For accessing the compressed stream
+    auto data() const noexcept {
+        return compressed_data;
+    }
+    auto size() const noexcept {
+        return compressed_size();
+    }
+    auto bytes() const noexcept {
+        return std::span<const unsigned char, result.size>(compressed_data);
+    }
+
+    // Returns the stream for passing on as-is, see huffman_encoded.
+    huffman_encoded encoded() const noexcept {
+        constexpr huffman_encoded::encoding_type encodings[] = {
+            huffman_encoded::deflate, huffman_encoded::zlib, huffman_encoded::gzip
+        };
+        return {encodings[options.format], std::as_bytes(bytes()), {},
+            uncompressed_size()};
+    }
+
+private:
+    unsigned char compressed_data[result.size] = {0};
+};
+
+template <detail::huffman_string_container hsc,
+    huffman_deflate_options options = huffman_deflate_options{}>
+constexpr auto huffman_compress_deflate = huffman_deflate_compressor<hsc, options>();
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_DEFLATE_HPP_
@@ -0,0 +1,145 @@
+/**
+ * generator.hpp - Coroutine-based incremental decompression.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_GENERATOR_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_GENERATOR_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+
+/**
+ * A generator of decompressed data chunks, produced by decode_chunks().
+ * Call next() once per scheduler tick to decode one more chunk, or use the
+ * generator in a range-based for loop to visit every chunk.
+ * @tparam T The element type of the decompressed data.
+ */
+template<typename T>
+class huffman_chunk_generator
+{
+public:
+    struct promise_type {
+        std::span<const T> chunk;
+
+        auto get_return_object() noexcept {
+            return huffman_chunk_generator(
+                std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_always final_suspend() const noexcept { return {}; }
+        std::suspend_always yield_value(std::span<const T> c) noexcept {
+            chunk = c;
+            return {};
+        }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::span<const T>;
+
+        iterator() = default;
+        explicit iterator(huffman_chunk_generator *gen) noexcept
+            : m_gen(gen) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const noexcept {
+            return m_gen == nullptr;
+        }
+        auto operator*() const noexcept {
+            return m_gen->chunk();
+        }
+        iterator& operator++() noexcept {
+            if (!m_gen->next())
+                m_gen = nullptr;
+            return *this;
+        }
+        void operator++(int) noexcept {
+            ++*this;
+        }
+
+    private:
+        huffman_chunk_generator *m_gen = nullptr;
+    };
+
+    huffman_chunk_generator(huffman_chunk_generator&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    huffman_chunk_generator& operator=(huffman_chunk_generator&& other) noexcept {
+        if (this != &other) {
+            if (m_handle)
+                m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+    ~huffman_chunk_generator() {
+        if (m_handle)
+            m_handle.destroy();
+    }
+
+    /**
+     * Decodes the next chunk.
+     * @return False once all data has been decoded.
+     */
+    bool next() noexcept {
+        if (!m_handle || m_handle.done())
+            return false;
+        m_handle.resume();
+        return !m_handle.done();
+    }
+
+    // The most recently decoded chunk. Valid until the next call to next().
+    auto chunk() const noexcept {
+        return m_handle.promise().chunk;
+    }
+
+    auto begin() noexcept { return iterator(this); }
+    auto end() const noexcept { return std::default_sentinel; }
+
+private:
+    explicit huffman_chunk_generator(std::coroutine_handle<promise_type> h) noexcept
+        : m_handle(h) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/**
+ * Incrementally decompresses the given data in chunks of chunk_size
+ * elements (the final chunk may be shorter). The decoder's position is kept
+ * in the coroutine frame between chunks, so decoding costs the same overall
+ * as a single pass while never stalling for longer than one chunk.
+ * @param comp The compressed data, which must outlive the generator.
+ * @param chunk_size Elements per chunk; zero is treated as one.
+ */
+template<typename compressor>
+huffman_chunk_generator<typename compressor::value_type>
+decode_chunks(const compressor& comp, std::size_t chunk_size)
+{
+    using T = typename compressor::value_type;
+
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+    auto buffer = std::make_unique<T[]>(chunk_size);
+    std::size_t count = 0;
+    for (auto it = comp.begin(), end = comp.end(); it != end; ++it) {
+        buffer[count] = static_cast<T>(*it);
+        if (++count == chunk_size) {
+            co_yield std::span<const T>(buffer.get(), count);
+            count = 0;
+        }
+    }
+
+    if (count > 0)
+        co_yield std::span<const T>(buffer.get(), count);
+}
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_GENERATOR_HPP_
@@ -0,0 +1,396 @@
+/**
+ * inflate.hpp - Run-time decoding of DEFLATE, zlib and gzip streams.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_INFLATE_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_INFLATE_HPP_
+
+#include "deflate.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace detail
+{
+    // Reads bits least significant first, keeping up to 64 of them buffered
+    // so that most reads need no memory access.
+    class huffman_inflate_bit_reader
+    {
+    public:
+        explicit huffman_inflate_bit_reader(std::span<const unsigned char> in) noexcept
+            : m_in(in.data()), m_end(in.data() + in.size()) {}
+
+        // Buffers at least 56 bits. Past the end of input, zeros are read.
+        void refill() noexcept {
+            if (m_end - m_in >= 8) {
+                std::uint64_t word = 0;
+                if constexpr (std::endian::native == std::endian::little) {
+                    std::memcpy(&word, m_in, 8);
+                } else {
+                    for (int i = 0; i < 8; i++)
+                        word |= std::uint64_t(m_in[i]) << (i * 8);
+                }
+                m_bits |= word << m_count;
+                m_in += (63 - m_count) >> 3;
+                m_count |= 56;
+            } else {
+                while (m_count <= 56) {
+                    if (m_in != m_end)
+                        m_bits |= std::uint64_t(*m_in++) << m_count;
+                    else
+                        m_padding += 8;
+                    m_count += 8;
+                }
+            }
+        }
+
+        unsigned int peek(unsigned int count) const noexcept {
+            return static_cast<unsigned int>(m_bits & ((1ull << count) - 1));
+        }
+        void consume(unsigned int count) noexcept {
+            m_bits >>= count;
+            m_count -= count;
+        }
+        unsigned int get(unsigned int count) noexcept {
+            auto value = peek(count);
+            consume(count);
+            return value;
+        }
+
+        // True if more bits were read than the input holds.
+        bool overrun() const noexcept {
+            return m_padding > m_count;
+        }
+
+        // Drops bits up to the next byte boundary, then hands back the rest
+        // of the input for reading byte-wise.
+        std::span<const unsigned char> take_bytes() noexcept {
+            consume(m_count % 8);
+            auto in = overrun() ? m_end : m_in - (m_count - m_padding) / 8;
+            m_in = m_end;
+            m_bits = 0;
+            m_count = 0;
+            m_padding = 0;
+            return {in, m_end};
+        }
+
+    private:
+        const unsigned char *m_in;
+        const unsigned char *m_end;
+        std::uint64_t m_bits = 0;
+        unsigned int m_count = 0;
+        unsigned int m_padding = 0;
+    };
+
+    /**
+     * Decodes the canonical Huffman code given by a list of code lengths.
+     * Codes up to fast_bits long take a single table lookup; longer codes
+     * are found from the range of codes of each length.
+     */
+    struct huffman_inflate_table {
+        constexpr static unsigned int fast_bits = 9;
+
+        std::uint16_t fast[1 << fast_bits] = {}; // (length << 9) | value, or 0
+        std::uint32_t max_code[17] = {}; // One past the last, left-aligned to 16 bits
+        std::uint16_t first_code[16] = {};
+        std::uint16_t first_index[16] = {};
+        std::uint16_t values[288] = {}; // Sorted by code
+
+        // Returns false if the lengths describe more codes than can exist.
+        constexpr bool build(const unsigned char *lengths, unsigned int count) noexcept {
+            unsigned int length_count[16] = {};
+            for (unsigned int i = 0; i < count; i++)
+                length_count[lengths[i]]++;
+            length_count[0] = 0;
+
+            std::uint16_t next_code[16] = {};
+            unsigned int code = 0, index = 0;
+            for (unsigned int length = 1; length < 16; length++) {
+                next_code[length] = static_cast<std::uint16_t>(code);
+                first_code[length] = static_cast<std::uint16_t>(code);
+                first_index[length] = static_cast<std::uint16_t>(index);
+                code += length_count[length];
+                index += length_count[length];
+                if (code > (1u << length))
+                    return false;
+                max_code[length] = code << (16 - length);
+                code <<= 1;
+            }
+            max_code[16] = 0x10000;
+
+            std::fill(fast, fast + (1 << fast_bits), 0);
+            for (unsigned int i = 0; i < count; i++) {
+                auto length = lengths[i];
+                if (length == 0)
+                    continue;
+                auto code = next_code[length]++;
+                values[code - first_code[length] + first_index[length]] =
+                    static_cast<std::uint16_t>(i);
+                if (length <= fast_bits) {
+                    unsigned int reversed = 0;
+                    for (unsigned int b = 0; b < length; b++)
+                        reversed |= ((code >> b) & 1u) << (length - 1 - b);
+                    for (; reversed < (1u << fast_bits); reversed += 1u << length)
+                        fast[reversed] = static_cast<std::uint16_t>((length << 9) | i);
+                }
+            }
+            return true;
+        }
+
+        // Reads one value, or returns -1 for an unused code. Needs 15 bits
+        // buffered.
+        int decode(huffman_inflate_bit_reader& reader) const noexcept {
+            if (auto entry = fast[reader.peek(fast_bits)]; entry != 0) {
+                reader.consume(entry >> 9);
+                return entry & 0x1FF;
+            }
+
+            unsigned int bits = reader.peek(16), code = 0;
+            for (int b = 0; b < 16; b++)
+                code |= ((bits >> b) & 1u) << (15 - b);
+            unsigned int length = fast_bits + 1;
+            while (code >= max_code[length])
+                length++;
+            if (length == 16)
+                return -1;
+            reader.consume(length);
+            return values[(code >> (16 - length)) - first_code[length] +
+                first_index[length]];
+        }
+    };
+
+    consteval auto huffman_inflate_fixed_tables() noexcept {
+        unsigned char lengths[288 + 30] = {};
+        std::fill(lengths, lengths + 144, 8);
+        std::fill(lengths + 144, lengths + 256, 9);
+        std::fill(lengths + 256, lengths + 280, 7);
+        std::fill(lengths + 280, lengths + 288, 8);
+        std::fill(lengths + 288, lengths + 318, 5);
+
+        std::array<huffman_inflate_table, 2> tables {};
+        tables[0].build(lengths, 288);
+        tables[1].build(lengths + 288, 30);
+        return tables;
+    }
+
+    inline constexpr auto huffman_inflate_fixed = huffman_inflate_fixed_tables();
+
+    // Reads a dynamic block's code lengths and builds its tables.
+    inline bool huffman_inflate_read_tables(huffman_inflate_bit_reader& reader,
+        huffman_inflate_table& literals, huffman_inflate_table& distances) noexcept
+    {
+        reader.refill();
+        auto literal_count = reader.get(5) + 257;
+        auto distance_count = reader.get(5) + 1;
+        auto code_length_count = reader.get(4) + 4;
+
+        unsigned char code_length_lengths[19] = {};
+        for (unsigned int i = 0; i < code_length_count; i++) {
+            if (i % 16 == 0)
+                reader.refill();
+            code_length_lengths[huffman_deflate_code_length_order[i]] =
+                static_cast<unsigned char>(reader.get(3));
+        }
+
+        huffman_inflate_table code_lengths;
+        if (!code_lengths.build(code_length_lengths, 19))
+            return false;
+
+        unsigned char lengths[288 + 32] = {};
+        auto total = literal_count + distance_count;
+        for (unsigned int n = 0; n < total;) {
+            reader.refill();
+            auto value = code_lengths.decode(reader);
+            if (value < 0)
+                return false;
+            if (value < 16) {
+                lengths[n++] = static_cast<unsigned char>(value);
+                continue;
+            }
+
+            unsigned char length = 0;
+            unsigned int repeat;
+            if (value == 16) {
+                if (n == 0)
+                    return false;
+                length = lengths[n - 1];
+                repeat = 3 + reader.get(2);
+            } else if (value == 17) {
+                repeat = 3 + reader.get(3);
+            } else {
+                repeat = 11 + reader.get(7);
+            }
+            if (n + repeat > total)
+                return false;
+            std::fill(lengths + n, lengths + n + repeat, length);
+            n += repeat;
+        }
+
+        return lengths[256] != 0 && !reader.overrun() &&
+            literals.build(lengths, literal_count) &&
+            distances.build(lengths + literal_count, distance_count);
+    }
+
+    // Decodes one Huffman-coded block into out, advancing pos.
+    inline bool huffman_inflate_block(huffman_inflate_bit_reader& reader,
+        const huffman_inflate_table& literals,
+        const huffman_inflate_table& distances,
+        std::span<unsigned char> out, std::size_t& pos) noexcept
+    {
+        auto *data = out.data();
+        while (1) {
+            // A length and distance, with their extra bits, fit in 48 bits.
+            reader.refill();
+            auto value = literals.decode(reader);
+            if (value < 256) {
+                if (value < 0 || pos == out.size())
+                    return false;
+                data[pos++] = static_cast<unsigned char>(value);
+                continue;
+            }
+            if (value == 256)
+                return !reader.overrun();
+
+            value -= 257;
+            if (value >= 29)
+                return false;
+            std::size_t length = huffman_deflate_length_base[value] +
+                reader.get(huffman_deflate_length_extra[value]);
+
+            auto code = distances.decode(reader);
+            if (code < 0 || code >= 30)
+                return false;
+            std::size_t distance = huffman_deflate_distance_base[code] +
+                reader.get(huffman_deflate_distance_extra[code]);
+
+            if (distance > pos || length > out.size() - pos)
+                return false;
+            auto *from = data + pos - distance;
+            if (distance >= length) {
+                std::memcpy(data + pos, from, length);
+            } else {
+                for (std::size_t i = 0; i < length; i++)
+                    data[pos + i] = from[i];
+            }
+            pos += length;
+        }
+    }
+
+    // Returns the size of a gzip header, or zero if it is invalid.
+    inline std::size_t huffman_gzip_header_size(std::span<const unsigned char> in) noexcept {
+        if (in.size() < 18 || in[0] != 0x1F || in[1] != 0x8B || in[2] != 8)
+            return 0;
+
+        auto flags = in[3];
+        std::size_t pos = 10;
+        if (flags & 4) // FEXTRA
+            pos += 2 + (in[10] | (in[11] << 8));
+        for (int field : {8, 16}) { // FNAME, FCOMMENT
+            if (flags & field) {
+                while (pos < in.size() && in[pos] != 0)
+                    pos++;
+                pos++;
+            }
+        }
+        if (flags & 2) // FHCRC
+            pos += 2;
+        return pos + 8 <= in.size() ? pos : 0;
+    }
+}
+
+/**
+ * Decompresses a DEFLATE, zlib or gzip stream, such as one made by
+ * huffman_compress_deflate. Every valid stream is accepted, and malformed
+ * input is rejected without reading or writing out of bounds. zlib and gzip
+ * checksums are verified.
+ * @param in The compressed stream.
+ * @param out Where to store the data; it must be large enough for all of it.
+ * @param format The stream's framing.
+ * @return The part of out that was written, or an empty span on failure.
+ */
+inline std::span<unsigned char> huffman_inflate(std::span<const unsigned char> in,
+    std::span<unsigned char> out,
+    huffman_deflate_options::format_type format = huffman_deflate_options::gzip) noexcept
+{
+    std::size_t header = 0;
+    if (format == huffman_deflate_options::gzip) {
+        header = detail::huffman_gzip_header_size(in);
+        if (header == 0)
+            return {};
+    } else if (format == huffman_deflate_options::zlib) {
+        if (in.size() < 6 || (in[0] & 0x0F) != 8 || (in[0] >> 4) > 7 ||
+            (in[0] << 8 | in[1]) % 31 != 0 || (in[1] & 0x20))
+        {
+            return {};
+        }
+        header = 2;
+    }
+
+    detail::huffman_inflate_bit_reader reader (in.subspan(header));
+    detail::huffman_inflate_table literals, distances;
+    std::size_t pos = 0;
+    bool last;
+    do {
+        reader.refill();
+        last = reader.get(1);
+        auto type = reader.get(2);
+
+        bool ok = false;
+        if (type == 0) {
+            auto bytes = reader.take_bytes();
+            if (bytes.size() < 4)
+                return {};
+            std::size_t length = bytes[0] | (bytes[1] << 8);
+            if ((length ^ (bytes[2] | (bytes[3] << 8))) != 0xFFFF ||
+                length > bytes.size() - 4 || length > out.size() - pos)
+            {
+                return {};
+            }
+            std::copy_n(bytes.data() + 4, length, out.data() + pos);
+            pos += length;
+            reader = detail::huffman_inflate_bit_reader(bytes.subspan(4 + length));
+            ok = true;
+        } else if (type == 1) {
+            ok = detail::huffman_inflate_block(reader, detail::huffman_inflate_fixed[0],
+                detail::huffman_inflate_fixed[1], out, pos);
+        } else if (type == 2) {
+            ok = detail::huffman_inflate_read_tables(reader, literals, distances) &&
+                detail::huffman_inflate_block(reader, literals, distances, out, pos);
+        }
+
+        if (!ok)
+            return {};
+    } while (!last);
+
+    auto trailer = reader.take_bytes();
+    auto get32 = [&trailer](std::size_t i, bool big_endian) {
+        std::uint32_t value = 0;
+        for (int j = 0; j < 4; j++)
+            value |= std::uint32_t(trailer[i + j]) << (big_endian ? 24 - j * 8 : j * 8);
+        return value;
+    };
+    if (format == huffman_deflate_options::gzip) {
+        if (trailer.size() < 8 ||
+            get32(0, false) != detail::huffman_crc32(out.data(), pos) ||
+            get32(4, false) != static_cast<std::uint32_t>(pos))
+        {
+            return {};
+        }
+    } else if (format == huffman_deflate_options::zlib) {
+        if (trailer.size() < 4 ||
+            get32(0, true) != detail::huffman_adler32(out.data(), pos))
+        {
+            return {};
+        }
+    }
+
+    return out.first(pos);
+}
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_INFLATE_HPP_
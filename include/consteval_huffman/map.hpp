@@ -0,0 +1,301 @@
+/**
+ * map.hpp - Compressed read-only maps with compile-time perfect hashing.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_MAP_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_MAP_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+
+namespace detail
+{
+    // Seeded 32-bit FNV-1a with a final avalanche step, so that different
+    // seeds give well-distributed, independent hashes.
+    constexpr std::uint32_t huffman_map_hash(std::string_view key,
+        std::uint32_t seed) noexcept
+    {
+        std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (auto c : key)
+            h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    // Selects the narrowest unsigned type that can hold max.
+    template<unsigned long int max>
+    using huffman_map_index_t = std::conditional_t<max <= 0xFF, std::uint8_t,
+        std::conditional_t<max <= 0xFFFF, std::uint16_t, std::uint32_t>>;
+}
+
+/**
+ * A read-only map from string keys to compressed string values.
+ * Keys are placed with a minimal perfect hash built at compile time (hash
+ * and displace), so find() costs two hashes and one key comparison. Values
+ * are compressed together with one model, as in huffman_string_table, and
+ * only the found value is decoded.
+ * @tparam entries Alternating keys and values: "key1", "value1", ...
+ */
+template<detail::huffman_string_container... entries>
+    requires(sizeof...(entries) > 0 && sizeof...(entries) % 2 == 0 &&
+        (std::same_as<std::remove_cvref_t<decltype(entries.data[0])>, char> && ...))
+class huffman_map
+{
+    using usize_t = unsigned long int;
+
+    constexpr static usize_t count = sizeof...(entries) / 2;
+
+    // Seeds tried per bucket before giving up on the perfect hash.
+    constexpr static std::uint32_t max_seed = 64 * count + 1024;
+
+    // Every key and value, concatenated without their nulls. Entry i spans
+    // [bounds[i], bounds[i + 1]) of text.
+    struct flat_entries {
+        std::array<char, ((entries.size() - 1) + ...) + 1> text {};
+        std::array<usize_t, count * 2 + 1> bounds {};
+    };
+
+    consteval static auto flatten() noexcept {
+        flat_entries f;
+        usize_t i = 0, offset = 0;
+        auto add = [&](const auto& e) consteval {
+            f.bounds[i++] = offset;
+            std::copy(e.data, e.data + e.size() - 1, f.text.begin() + offset);
+            offset += e.size() - 1;
+        };
+        (add(entries), ...);
+        f.bounds[i] = offset;
+        return f;
+    }
+
+    constexpr static auto flat = flatten();
+
+    consteval static std::string_view entry(usize_t i) noexcept {
+        return std::string_view(flat.text.data() + flat.bounds[i],
+            flat.bounds[i + 1] - flat.bounds[i]);
+    }
+    consteval static std::string_view key(usize_t i) noexcept {
+        return entry(i * 2);
+    }
+    consteval static std::string_view value(usize_t i) noexcept {
+        return entry(i * 2 + 1);
+    }
+
+    consteval static auto keys() noexcept {
+        std::array<std::string_view, count> k {};
+        for (usize_t i = 0; i < count; i++)
+            k[i] = key(i);
+        return k;
+    }
+
+    consteval static bool has_unique_keys() noexcept {
+        auto k = keys();
+        std::sort(k.begin(), k.end());
+        return std::adjacent_find(k.begin(), k.end()) == k.end();
+    }
+    static_assert(has_unique_keys(), "huffman_map keys must be unique");
+
+    consteval static usize_t values_size() noexcept {
+        usize_t size = 0;
+        for (usize_t i = 0; i < count; i++)
+            size += value(i).size();
+        return size;
+    }
+
+    // All values, concatenated. A single null stands in if all are empty.
+    consteval static auto join_values() noexcept {
+        char all[std::max<usize_t>(values_size(), 1)] = {};
+        auto out = all;
+        for (usize_t i = 0; i < count; i++)
+            out = std::copy(value(i).begin(), value(i).end(), out);
+        return detail::huffman_string_container(all);
+    }
+
+    constexpr static auto values_text = join_values();
+
+    using entry_index = detail::huffman_map_index_t<count>;
+
+    struct perfect_hash {
+        std::array<std::uint32_t, count> seeds {};
+        std::array<entry_index, count> slots {};
+        bool valid = true;
+    };
+
+    /**
+     * Builds the perfect hash: keys are grouped into buckets by an unseeded
+     * hash, then, largest bucket first, each bucket is given the first seed
+     * that sends all of its keys to free slots.
+     */
+    consteval static auto build_hash() noexcept {
+        auto k = keys();
+        perfect_hash ph;
+        std::array<usize_t, count> bucket_of {};
+        std::array<usize_t, count + 1> bucket_start {};
+        std::array<usize_t, count> members {};
+        std::array<usize_t, count> order {};
+        std::array<bool, count> taken {};
+
+        // Sort keys by bucket, so that each bucket's keys are adjacent
+        for (usize_t i = 0; i < count; i++) {
+            bucket_of[i] = detail::huffman_map_hash(k[i], 0) % count;
+            bucket_start[bucket_of[i] + 1]++;
+            order[i] = i;
+        }
+        for (usize_t b = 0; b < count; b++)
+            bucket_start[b + 1] += bucket_start[b];
+        auto next = bucket_start;
+        for (usize_t i = 0; i < count; i++)
+            members[next[bucket_of[i]]++] = i;
+
+        auto size_of = [&](usize_t b) { return bucket_start[b + 1] - bucket_start[b]; };
+        std::sort(order.begin(), order.end(), [&](auto a, auto b) {
+            return size_of(a) != size_of(b) ? size_of(a) > size_of(b) : a < b;
+        });
+
+        std::array<usize_t, count> trial {};
+        for (auto bucket : order) {
+            if (size_of(bucket) == 0)
+                break;
+
+            std::uint32_t seed = 1;
+            for (; seed <= max_seed; seed++) {
+                usize_t placed = 0;
+                for (auto m = bucket_start[bucket]; m < bucket_start[bucket + 1]; m++) {
+                    auto slot = detail::huffman_map_hash(k[members[m]], seed) % count;
+                    if (taken[slot])
+                        break;
+                    taken[slot] = true;
+                    trial[placed++] = slot;
+                }
+                if (placed == size_of(bucket))
+                    break;
+                while (placed > 0)
+                    taken[trial[--placed]] = false;
+            }
+
+            if (seed > max_seed) {
+                ph.valid = false;
+                break;
+            }
+            ph.seeds[bucket] = seed;
+            for (usize_t m = 0; m < size_of(bucket); m++) {
+                ph.slots[trial[m]] = static_cast<entry_index>(
+                    members[bucket_start[bucket] + m]);
+            }
+        }
+
+        return ph;
+    }
+
+    constexpr static auto hash = build_hash();
+    static_assert(hash.valid, "huffman_map found no perfect hash for these keys; "
+        "a bucket's keys collide under every seed tried");
+
+    consteval static auto key_data_size() noexcept {
+        usize_t size = 0;
+        for (auto k : keys())
+            size += k.size();
+        return size;
+    }
+
+    // All keys, concatenated in slot order, and where each slot's key begins.
+    struct key_store {
+        std::array<char, key_data_size() + 1> chars {};
+        std::array<detail::huffman_map_index_t<key_data_size()>, count + 1> offsets {};
+    };
+
+    consteval static auto build_keys() noexcept {
+        auto k = keys();
+        key_store store;
+        usize_t offset = 0;
+        for (usize_t slot = 0; slot < count; slot++) {
+            store.offsets[slot] = offset;
+            auto key = k[hash.slots[slot]];
+            std::copy(key.begin(), key.end(), store.chars.begin() + offset);
+            offset += key.size();
+        }
+        store.offsets[count] = offset;
+        return store;
+    }
+
+    constexpr static auto key_data = build_keys();
+
+public:
+    using compressor = huffman_compressor<values_text>;
+
+    // Value index entries are as narrow as the total bit count allows.
+    using offset_type = std::conditional_t<
+        std::max<usize_t>(compressor::compressed_size(),
+            compressor::uncompressed_size()) * 8 <= 0xFFFF,
+        std::uint16_t, std::uint32_t>;
+
+    // The compressed values, concatenated in the order they were given.
+    compressor values;
+
+private:
+    consteval static auto build_offsets() noexcept {
+        constexpr auto lengths = compressor::code_lengths();
+        std::array<offset_type, count + 1> offsets {};
+        usize_t bit = 0;
+        for (usize_t i = 0; i < count; i++) {
+            offsets[i] = static_cast<offset_type>(bit);
+            for (auto c : value(i))
+                bit += lengths[static_cast<unsigned char>(c)];
+        }
+        offsets[count] = static_cast<offset_type>(bit);
+        return offsets;
+    }
+
+    constexpr static auto offsets = build_offsets();
+
+    // Returns a range that decodes the i-th value.
+    auto value_at(usize_t i) const noexcept {
+        return std::ranges::subrange(
+            values.at({offsets[i], 0}),
+            values.at({offsets[i + 1], 0}));
+    }
+
+public:
+    consteval huffman_map() noexcept = default;
+
+    // Returns the number of entries in the map.
+    constexpr static auto size() noexcept {
+        return count;
+    }
+
+    /**
+     * Looks up the given key.
+     * @return A range that decodes the key's value, or std::nullopt if the
+     *         key is not in the map.
+     */
+    auto find(std::string_view key) const noexcept
+        -> std::optional<decltype(value_at(0))>
+    {
+        auto bucket = detail::huffman_map_hash(key, 0) % count;
+        auto slot = detail::huffman_map_hash(key, hash.seeds[bucket]) % count;
+        auto stored = std::string_view(key_data.chars.data() + key_data.offsets[slot],
+            key_data.offsets[slot + 1] - key_data.offsets[slot]);
+        if (stored != key)
+            return std::nullopt;
+
+        return value_at(hash.slots[slot]);
+    }
+    bool contains(std::string_view key) const noexcept {
+        return find(key).has_value();
+    }
+};
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_MAP_HPP_
@@ -0,0 +1,163 @@
+/**
+ * model.hpp - Run-time coding with a Huffman model trained at compile-time.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_MODEL_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_MODEL_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * A fixed Huffman model built at compile-time from sample data, for coding
+ * short run-time messages that resemble the sample. Since both sides share
+ * the model, messages carry no header or decode tree.
+ * Values that never occur in the sample are coded as an escape code
+ * followed by the value's eight bits.
+ * @tparam training Sample data with a representative value distribution.
+ */
+template<detail::huffman_string_container training>
+class huffman_model
+{
+    using usize_t = unsigned long int;
+
+    constexpr static int escape = 256;
+
+    consteval static auto build_node_tree() noexcept {
+        long int freq[257] = {};
+        for (usize_t i = 0; i < training.size(); i++)
+            freq[static_cast<unsigned char>(training.data[i])]++;
+        // Only reserve an escape code if some value needs one
+        freq[escape] = std::count(freq, freq + 256, 0) > 0 ? 1 : 0;
+        return detail::huffman_build_node_tree(
+            detail::huffman_build_node_list(freq, 257));
+    }
+
+    consteval static auto tree_count() noexcept {
+        auto tree = build_node_tree();
+        auto count = tree.size();
+        delete[] tree.data();
+        return count;
+    }
+
+    struct code_table {
+        std::array<std::uint32_t, 257> codes {};
+        std::array<unsigned char, 257> lengths {};
+        std::array<unsigned char, tree_count() * 3> decode_tree {};
+        usize_t escape_node = 0;
+        bool valid = true;
+    };
+
+    consteval static auto build_code_table() noexcept {
+        auto tree = build_node_tree();
+        code_table table;
+
+        for (usize_t i = tree.size(); i-- > 0;) {
+            auto leaf = tree.begin() + i;
+            if (leaf->value > escape)
+                continue;
+            std::uint32_t code = 0;
+            unsigned char length = 0;
+            for (auto n = leaf; n->parent != -1; n = tree.begin() + n->parent) {
+                if (tree[n->parent].right == n->value)
+                    code |= std::uint32_t(1) << length;
+                length++;
+            }
+            table.codes[leaf->value] = code;
+            table.lengths[leaf->value] = length;
+            table.valid &= length <= 32;
+            if (leaf->value == escape)
+                table.escape_node = i;
+        }
+
+        table.valid &= detail::huffman_write_decode_tree(tree,
+            table.decode_tree.data());
+        delete[] tree.data();
+        return table;
+    }
+
+    constexpr static auto table = build_code_table();
+    static_assert(table.valid, "training data gives a Huffman tree that cannot be "
+        "stored: a code is longer than 32 bits, or a node's child is more than "
+        "255 nodes away in the decode tree");
+
+    consteval static usize_t max_code_length() noexcept {
+        usize_t max = table.lengths[escape] + 8;
+        for (int i = 0; i < 256; i++) {
+            if (table.lengths[i] != 0)
+                max = std::max<usize_t>(max, table.lengths[i]);
+        }
+        return max;
+    }
+
+public:
+    /**
+     * Returns the largest possible encoded size of a message, which is the
+     * size needed for encode()'s output buffer.
+     */
+    constexpr static usize_t max_encoded_size(usize_t message_size) noexcept {
+        return message_size * max_code_length() / 8 + 1;
+    }
+
+    /**
+     * Encodes a message with the model.
+     * @param message The data to encode.
+     * @param out Zero-initialized buffer of max_encoded_size() bytes.
+     * @return The number of bytes used.
+     */
+    static usize_t encode(std::span<const unsigned char> message,
+        unsigned char *out) noexcept
+    {
+        detail::huffman_bit_writer writer {out};
+        usize_t bits = 0;
+        for (auto c : message) {
+            if (table.lengths[c] != 0) {
+                writer.put(table.codes[c], table.lengths[c]);
+                bits += table.lengths[c];
+            } else {
+                writer.put(table.codes[escape], table.lengths[escape]);
+                writer.put(c, 8);
+                bits += table.lengths[escape] + 8;
+            }
+        }
+
+        return bits / 8 + 1;
+    }
+
+    /**
+     * Decodes a message encoded by encode().
+     * @param in The encoded message.
+     * @param out Where to store the message; its size must be the size of
+     *            the original message.
+     */
+    static void decode(const unsigned char *in,
+        std::span<unsigned char> out) noexcept
+    {
+        auto *escape_node = table.decode_tree.data() + table.escape_node * 3;
+        unsigned char bit = 0x80, length;
+        for (auto& c : out) {
+            auto *node = detail::huffman_decode_node(table.decode_tree.data(),
+                in, bit, length);
+            if (node != escape_node || table.lengths[escape] == 0) {
+                c = *node;
+                continue;
+            }
+
+            c = 0;
+            for (int i = 0; i < 8; i++) {
+                c = (c << 1) | ((*in & bit) ? 1 : 0);
+                bit >>= 1;
+                if (!bit)
+                    bit = 0x80, in++;
+            }
+        }
+    }
+};
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_MODEL_HPP_
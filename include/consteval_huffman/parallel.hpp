@@ -0,0 +1,108 @@
+/**
+ * parallel.hpp - Parallel bulk decompression of many huffman_compressors.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_PARALLEL_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_PARALLEL_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+/**
+ * A type-erased handle to one compressed literal, for use with decode_all().
+ * After decode_all() returns, output views the decompressed data.
+ * Only compressors of byte-sized values are accepted, since output is a
+ * byte arena; decode wider values with the compressor's own decode().
+ */
+struct huffman_decode_job {
+    template<typename compressor>
+        requires(sizeof(typename compressor::value_type) == 1)
+    huffman_decode_job(const compressor& c) noexcept
+        : source(&c),
+          size(compressor::uncompressed_size()),
+          decode([](const void *src, unsigned char *out) {
+              auto& comp = *static_cast<const compressor *>(src);
+              std::copy(comp.begin(), comp.end(), out);
+          }) {}
+
+    const void *source;
+    std::size_t size;
+    void (*decode)(const void *, unsigned char *);
+    std::span<unsigned char> output;
+};
+
+/**
+ * Decompresses every job into the given arena using a pool of threads.
+ * Jobs are handed out largest-first, dealt round-robin into one queue per
+ * thread. A thread that empties its own queue steals from the others, so
+ * the load stays balanced even when literal sizes vary widely.
+ * @param jobs The literals to decompress; each job's output is set.
+ * @param arena Storage for the output, at least the sum of job sizes.
+ * @param thread_count Threads to use, including the caller. Zero selects
+ *                     std::thread::hardware_concurrency().
+ * @return False if the arena is too small, in which case nothing is decoded.
+ */
+inline bool decode_all(std::span<huffman_decode_job> jobs,
+    std::span<unsigned char> arena, unsigned int thread_count = 0)
+{
+    auto total = std::accumulate(jobs.begin(), jobs.end(), std::size_t(0),
+        [](auto sum, const auto& job) { return sum + job.size; });
+    if (total > arena.size())
+        return false;
+
+    for (auto& job : jobs) {
+        job.output = arena.first(job.size);
+        arena = arena.subspan(job.size);
+    }
+
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_count = std::min<std::size_t>(thread_count, std::max<std::size_t>(jobs.size(), 1));
+
+    std::vector<std::size_t> order (jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&jobs](auto a, auto b) { return jobs[a].size > jobs[b].size; });
+
+    // Thread t owns the jobs at order[t], order[t + thread_count], ...
+    // Each queue's cursor sits on its own cache line.
+    struct alignas(64) queue {
+        std::atomic<std::size_t> next = 0;
+    };
+    auto queues = std::make_unique<queue[]>(thread_count);
+
+    auto worker = [&](unsigned int self) {
+        for (unsigned int i = 0; i < thread_count; i++) {
+            auto victim = (self + i) % thread_count;
+            while (1) {
+                auto n = queues[victim].next.fetch_add(1, std::memory_order_relaxed);
+                auto index = victim + n * thread_count;
+                if (index >= order.size())
+                    break;
+                auto& job = jobs[order[index]];
+                job.decode(job.source, job.output.data());
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned int i = 1; i < thread_count; i++)
+        threads.emplace_back(worker, i);
+    worker(0);
+    for (auto& t : threads)
+        t.join();
+
+    return true;
+}
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_PARALLEL_HPP_
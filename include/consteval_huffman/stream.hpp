@@ -0,0 +1,200 @@
+/**
+ * stream.hpp - Run-time Huffman coding of streamed data.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_STREAM_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_STREAM_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace detail
+{
+    inline void huffman_stream_put32(std::vector<unsigned char>& out,
+        std::uint32_t value)
+    {
+        for (int i = 0; i < 4; i++)
+            out.push_back(static_cast<unsigned char>(value >> (i * 8)));
+    }
+
+    inline std::uint32_t huffman_stream_get32(const unsigned char *in) noexcept {
+        return in[0] | (in[1] << 8) | (in[2] << 16) |
+            (static_cast<std::uint32_t>(in[3]) << 24);
+    }
+}
+
+/**
+ * Compresses data at run-time using semi-static Huffman coding: incoming
+ * data is split into blocks, and each block is coded with a tree built from
+ * its own frequencies. The coder adapts to changes in the data from one
+ * block to the next, at the cost of a decode tree in each block header.
+ *
+ * Block format:
+ *     1 byte:  Block type (0 = stored, 1 = Huffman coded).
+ *     4 bytes: Uncompressed size.
+ *     Stored blocks: the uncompressed data.
+ *     Huffman blocks: 2 bytes node count, 4 bytes payload size, the decode
+ *     tree (same layout as huffman_compressor's), then the payload.
+ * Multi-byte fields are little-endian. A block is stored whenever coding
+ * would not make it smaller.
+ */
+class huffman_stream_encoder
+{
+public:
+    enum : unsigned char { stored_block, huffman_block };
+
+    /**
+     * @param out Where to append encoded blocks.
+     * @param block_size Uncompressed bytes per block; zero is treated as one.
+     */
+    explicit huffman_stream_encoder(std::vector<unsigned char>& out,
+        std::size_t block_size = 4096)
+        : m_out(out), m_block_size(std::max<std::size_t>(block_size, 1))
+    {
+        m_buffer.reserve(m_block_size);
+    }
+
+    void write(std::span<const unsigned char> data) {
+        while (!data.empty()) {
+            auto count = std::min(data.size(), m_block_size - m_buffer.size());
+            m_buffer.insert(m_buffer.end(), data.begin(), data.begin() + count);
+            data = data.subspan(count);
+            if (m_buffer.size() == m_block_size)
+                flush();
+        }
+    }
+
+    // Encodes any buffered data as a (possibly short) block.
+    void flush() {
+        if (!m_buffer.empty()) {
+            encode_block(m_buffer);
+            m_buffer.clear();
+        }
+    }
+
+private:
+    void encode_block(std::span<const unsigned char> block) {
+        long int freq[256] = {};
+        for (auto c : block)
+            freq[c]++;
+        auto tree = detail::huffman_build_node_tree(
+            detail::huffman_build_node_list(freq));
+
+        // Collect each value's code, with the root's branch as the most
+        // significant bit.
+        std::uint64_t codes[256] = {};
+        unsigned char lengths[256] = {};
+        for (auto leaf = tree.end(); leaf-- != tree.begin();) {
+            if (leaf->value > 0xFF)
+                continue;
+            std::uint64_t code = 0;
+            unsigned char length = 0;
+            for (auto n = leaf; n->parent != -1; n = tree.begin() + n->parent) {
+                if (tree[n->parent].right == n->value)
+                    code |= std::uint64_t(1) << length;
+                length++;
+            }
+            codes[leaf->value] = code;
+            lengths[leaf->value] = length;
+        }
+
+        std::vector<unsigned char> table (tree.size() * 3);
+        bool fits = detail::huffman_write_decode_tree(tree, table.data());
+        auto nodes = tree.size();
+        delete[] tree.data();
+
+        std::size_t bits = 0;
+        for (auto c : block)
+            bits += lengths[c];
+        std::size_t payload_size = bits / 8 + 1;
+
+        auto type = !fits || 6 + table.size() + payload_size >= block.size()
+            ? stored_block : huffman_block;
+        m_out.push_back(type);
+        detail::huffman_stream_put32(m_out, block.size());
+        if (type == stored_block) {
+            m_out.insert(m_out.end(), block.begin(), block.end());
+            return;
+        }
+
+        m_out.push_back(static_cast<unsigned char>(nodes));
+        m_out.push_back(static_cast<unsigned char>(nodes >> 8));
+        detail::huffman_stream_put32(m_out, payload_size);
+        m_out.insert(m_out.end(), table.begin(), table.end());
+
+        auto payload = m_out.size();
+        m_out.resize(payload + payload_size);
+        detail::huffman_bit_writer writer {m_out.data() + payload};
+        for (auto c : block)
+            writer.put(codes[c], lengths[c]);
+    }
+
+    std::vector<unsigned char>& m_out;
+    std::vector<unsigned char> m_buffer;
+    std::size_t m_block_size;
+};
+
+/**
+ * Decompresses a stream produced by huffman_stream_encoder, one block at a
+ * time. The stream is trusted: truncated blocks and unknown block types end
+ * decoding, but corrupt decode trees are not detected.
+ */
+class huffman_stream_decoder
+{
+public:
+    explicit huffman_stream_decoder(std::span<const unsigned char> stream)
+        : m_stream(stream) {}
+
+    /**
+     * Decodes the next block.
+     * @return The block's data, valid until the next call, or an empty span
+     *         at the end of the stream.
+     */
+    std::span<const unsigned char> next() {
+        if (m_stream.size() < 5)
+            return {};
+
+        auto type = m_stream[0];
+        auto size = detail::huffman_stream_get32(m_stream.data() + 1);
+        m_stream = m_stream.subspan(5);
+
+        if (type == huffman_stream_encoder::stored_block) {
+            if (m_stream.size() < size)
+                return m_stream = {}, std::span<const unsigned char>();
+            auto block = m_stream.first(size);
+            m_stream = m_stream.subspan(size);
+            return block;
+        }
+
+        if (type != huffman_stream_encoder::huffman_block || m_stream.size() < 6)
+            return m_stream = {}, std::span<const unsigned char>();
+        std::size_t nodes = m_stream[0] | (m_stream[1] << 8);
+        auto payload_size = detail::huffman_stream_get32(m_stream.data() + 2);
+        m_stream = m_stream.subspan(6);
+        if (nodes == 0 || m_stream.size() < nodes * 3 + payload_size)
+            return m_stream = {}, std::span<const unsigned char>();
+
+        auto *table = m_stream.data();
+        auto *data = table + nodes * 3;
+        m_stream = m_stream.subspan(nodes * 3 + payload_size);
+
+        m_block.resize(size);
+        unsigned char bit = 0x80, length;
+        for (auto& c : m_block)
+            c = static_cast<unsigned char>(
+                detail::huffman_decode_one(table, data, bit, length));
+        return m_block;
+    }
+
+private:
+    std::span<const unsigned char> m_stream;
+    std::vector<unsigned char> m_block;
+};
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_STREAM_HPP_
@@ -0,0 +1,91 @@
+/**
+ * string_table.hpp - Compresses a table of strings with a single model.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_STRING_TABLE_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_STRING_TABLE_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+
+/**
+ * Compresses a list of strings together, sharing one Huffman model and
+ * decode tree between them. Individual strings are located through an index
+ * of bit offsets, so any string can be decoded without touching the others.
+ * With GCC's default -fconstexpr-ops-limit, tables of up to about 80 KB of
+ * text compile; raise the limit for larger ones.
+ * @tparam strings The strings to store. Terminating nulls are not stored.
+ */
+template<detail::huffman_string_container... strings>
+    requires(sizeof...(strings) > 0 &&
+        (std::same_as<std::remove_cvref_t<decltype(strings.data[0])>, char> && ...) &&
+        ((strings.size() - 1) + ...) > 0)
+class huffman_string_table
+{
+    using usize_t = unsigned long int;
+
+    consteval static auto concatenate() noexcept {
+        char all[((strings.size() - 1) + ...)] = {};
+        auto out = all;
+        ((out = std::copy(strings.data, strings.data + strings.size() - 1, out)), ...);
+        return detail::huffman_string_container(all);
+    }
+
+    constexpr static auto concatenated = concatenate();
+
+public:
+    using compressor = huffman_compressor<concatenated>;
+
+    // Index entries are as narrow as the total bit count allows.
+    using offset_type = std::conditional_t<
+        std::max<usize_t>(compressor::compressed_size(),
+            compressor::uncompressed_size()) * 8 <= 0xFFFF,
+        std::uint16_t, std::uint32_t>;
+
+private:
+    consteval static auto build_offsets() noexcept {
+        constexpr auto lengths = compressor::code_lengths();
+        std::array<offset_type, sizeof...(strings) + 1> offsets {};
+        usize_t i = 0, bit = 0;
+        auto add = [&](const auto& str) consteval {
+            offsets[i++] = static_cast<offset_type>(bit);
+            for (usize_t j = 0; j < str.size() - 1; j++)
+                bit += lengths[static_cast<unsigned char>(str.data[j])];
+        };
+        (add(strings), ...);
+        offsets[i] = static_cast<offset_type>(bit);
+        return offsets;
+    }
+
+public:
+    constexpr static auto offsets = build_offsets();
+
+    consteval huffman_string_table() noexcept = default;
+
+    // Returns the number of strings in the table.
+    constexpr static auto size() noexcept {
+        return sizeof...(strings);
+    }
+
+    /**
+     * Returns a range that decodes the i-th string. Decoder positions
+     * within the range are indexed relative to the start of the string.
+     */
+    auto operator[](usize_t i) const noexcept {
+        return std::ranges::subrange(
+            data.at({offsets[i], 0}),
+            data.at({offsets[i + 1], 0}));
+    }
+
+    // The compressed strings and their shared decode tree.
+    compressor data;
+};
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_STRING_TABLE_HPP_
@@ -0,0 +1,725 @@
+/**
+ * transform.hpp - Reversible transforms applied before Huffman coding.
+ * https://github.com/tcsullivan/consteval-huffman
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_TRANSFORM_HPP_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_TRANSFORM_HPP_
+
+#include "consteval_huffman.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace detail
+{
+    /**
+     * Burrows-Wheeler transform. Rotations are sorted by prefix doubling with
+     * a two-pass counting sort, keeping the work linear per pass so that
+     * large literals stay within the compiler's constexpr step limits.
+     * @param out Receives the last column of the sorted rotations.
+     * @return Row of the sorted rotations that holds the original data.
+     */
+    constexpr unsigned long int huffman_bwt(const unsigned char *in,
+        unsigned char *out, unsigned long int n) noexcept
+    {
+        auto ranks = std::max(n, 256ul);
+        auto *sa = new unsigned long int[n];
+        auto *sorted = new unsigned long int[n];
+        auto *rank = new unsigned long int[n];
+        auto *next_rank = new unsigned long int[n];
+        auto *start = new unsigned long int[ranks];
+        for (unsigned long int i = 0; i < n; i++)
+            sa[i] = i, rank[i] = in[i];
+
+        // Stable counting sort of from into to, by rank[(i + offset) % n]
+        auto sort_by = [&](const auto *from, auto *to, unsigned long int offset) {
+            std::fill(start, start + ranks, 0);
+            for (unsigned long int i = 0; i < n; i++)
+                start[rank[(from[i] + offset) % n]]++;
+            for (unsigned long int r = 0, sum = 0; r < ranks; r++)
+                sum += std::exchange(start[r], sum);
+            for (unsigned long int i = 0; i < n; i++)
+                to[start[rank[(from[i] + offset) % n]]++] = from[i];
+        };
+
+        // Sort rotations by their first 2k characters, doubling k each pass
+        for (unsigned long int k = 1;; k *= 2) {
+            sort_by(sa, sorted, k % n);
+            sort_by(sorted, sa, 0);
+
+            auto key = [&](auto i) {
+                return std::pair(rank[i], rank[(i + k) % n]);
+            };
+            next_rank[sa[0]] = 0;
+            for (unsigned long int i = 1; i < n; i++)
+                next_rank[sa[i]] = next_rank[sa[i - 1]] + (key(sa[i - 1]) < key(sa[i]));
+            std::copy(next_rank, next_rank + n, rank);
+
+            if (rank[sa[n - 1]] == n - 1 || k >= n)
+                break;
+        }
+
+        unsigned long int primary = 0;
+        for (unsigned long int i = 0; i < n; i++) {
+            out[i] = in[(sa[i] + n - 1) % n];
+            if (sa[i] == 0)
+                primary = i;
+        }
+
+        delete[] sa;
+        delete[] sorted;
+        delete[] rank;
+        delete[] next_rank;
+        delete[] start;
+        return primary;
+    }
+
+    // Reverses huffman_bwt(), walking the last-to-first mapping.
+    inline void huffman_inverse_bwt(const unsigned char *in, unsigned char *out,
+        unsigned long int n, unsigned long int primary)
+    {
+        unsigned long int start[256] = {};
+        for (unsigned long int i = 0; i < n; i++)
+            start[in[i]]++;
+        for (unsigned long int c = 0, sum = 0; c < 256; c++)
+            sum += std::exchange(start[c], sum);
+
+        auto lf = std::make_unique<std::uint32_t[]>(n);
+        for (unsigned long int i = 0; i < n; i++)
+            lf[i] = static_cast<std::uint32_t>(start[in[i]]++);
+
+        for (auto i = n, row = primary; i-- > 0; row = lf[row])
+            out[i] = in[row];
+    }
+
+    // Move-to-front transform: each value becomes its index in a list of
+    // recently seen values. Applied in place.
+    constexpr void huffman_mtf(unsigned char *data, unsigned long int n) noexcept {
+        unsigned char order[256] = {};
+        for (int i = 0; i < 256; i++)
+            order[i] = static_cast<unsigned char>(i);
+        for (unsigned long int i = 0; i < n; i++) {
+            auto pos = std::find(order, order + 256, data[i]);
+            std::copy_backward(order, pos, pos + 1);
+            order[0] = data[i];
+            data[i] = static_cast<unsigned char>(pos - order);
+        }
+    }
+
+    // Reverses huffman_mtf(), in place.
+    inline void huffman_inverse_mtf(unsigned char *data, unsigned long int n) noexcept {
+        unsigned char order[256];
+        for (int i = 0; i < 256; i++)
+            order[i] = static_cast<unsigned char>(i);
+        for (unsigned long int i = 0; i < n; i++) {
+            auto index = data[i];
+            auto c = order[index];
+            std::memmove(order + 1, order, index);
+            order[0] = c;
+            data[i] = c;
+        }
+    }
+
+    /**
+     * Run-length encoding: two equal values in a row are followed by a count
+     * of how many more times the value repeats (up to 255).
+     * @param out Receives the encoded data; may be null to only measure.
+     * @return The size of the encoded data.
+     */
+    constexpr unsigned long int huffman_rle(const unsigned char *in,
+        unsigned long int n, unsigned char *out) noexcept
+    {
+        unsigned long int size = 0;
+        auto put = [&](unsigned char c) {
+            if (out != nullptr)
+                out[size] = c;
+            size++;
+        };
+
+        for (unsigned long int i = 0; i < n;) {
+            unsigned long int run = 1;
+            while (i + run < n && in[i + run] == in[i] && run < 257)
+                run++;
+
+            put(in[i]);
+            if (run >= 2) {
+                put(in[i]);
+                put(static_cast<unsigned char>(run - 2));
+            }
+            i += run;
+        }
+
+        return size;
+    }
+
+    // Reverses huffman_rle(), filling runs with memset.
+    inline void huffman_inverse_rle(const unsigned char *in, unsigned long int n,
+        unsigned char *out) noexcept
+    {
+        for (unsigned long int i = 0; i < n;) {
+            auto c = in[i++];
+            *out++ = c;
+            if (i < n && in[i] == c) {
+                *out++ = c;
+                auto count = in[i + 1];
+                std::memset(out, c, count);
+                out += count;
+                i += 2;
+            }
+        }
+    }
+
+    // Adds eight bytes lane-wise, without carries between lanes.
+    constexpr std::uint64_t huffman_add_bytes(std::uint64_t a, std::uint64_t b) noexcept {
+        constexpr std::uint64_t low = 0x7F7F7F7F7F7F7F7Full;
+        return ((a & low) + (b & low)) ^ ((a ^ b) & ~low);
+    }
+
+    // Reverses a stride-one delta filter, in place: a running sum computed
+    // eight bytes at a time with a SWAR (SIMD within a register) scan.
+    inline void huffman_inverse_delta(unsigned char *data, unsigned long int n) noexcept {
+        unsigned char sum = 0;
+        unsigned long int i = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; i + 8 <= n; i += 8) {
+                std::uint64_t x;
+                std::memcpy(&x, data + i, 8);
+                x = huffman_add_bytes(x, x << 8);
+                x = huffman_add_bytes(x, x << 16);
+                x = huffman_add_bytes(x, x << 32);
+                x = huffman_add_bytes(x, sum * 0x0101010101010101ull);
+                std::memcpy(data + i, &x, 8);
+                sum = data[i + 7];
+            }
+        }
+        for (; i < n; i++)
+            sum = data[i] = static_cast<unsigned char>(data[i] + sum);
+    }
+
+    // Reverses a stride-one XOR filter, in place, eight bytes at a time.
+    inline void huffman_inverse_xor(unsigned char *data, unsigned long int n) noexcept {
+        unsigned char sum = 0;
+        unsigned long int i = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            for (; i + 8 <= n; i += 8) {
+                std::uint64_t x;
+                std::memcpy(&x, data + i, 8);
+                x ^= x << 8;
+                x ^= x << 16;
+                x ^= x << 32;
+                x ^= sum * 0x0101010101010101ull;
+                std::memcpy(data + i, &x, 8);
+                sum = data[i + 7];
+            }
+        }
+        for (; i < n; i++)
+            sum = data[i] ^= sum;
+    }
+
+    // Stores transformed data as a container that huffman_compressor accepts.
+    template<unsigned long int N>
+    consteval auto huffman_make_container(const unsigned char *data) noexcept {
+        unsigned char copy[N] = {};
+        std::copy(data, data + N, copy);
+        return huffman_string_container(copy);
+    }
+}
+
+/**
+ * Compresses the given data with a Burrows-Wheeler transform, move-to-front
+ * and run-length encoding ahead of Huffman coding. The transforms group
+ * repeated contexts together and skew values towards zero, which usually
+ * compresses text far better than Huffman coding alone. Decompression is
+ * slower and needs temporary memory, so this suits large, rarely-read data.
+ * @tparam raw_data The string of data to be compressed.
+ */
+template<auto raw_data>
+    requires(raw_data.size() > 0)
+class huffman_bwt_compressor
+{
+    using usize_t = unsigned long int;
+
+    struct transform_result {
+        // Run-length encoding expands data by at most half, when every run
+        // is two values long (each becomes three)
+        std::array<unsigned char, raw_data.size() * 3 / 2 + 1> data {};
+        usize_t size = 0;
+        usize_t primary = 0;
+    };
+
+    consteval static auto transform() noexcept {
+        auto n = raw_data.size();
+        auto *in = new unsigned char[n];
+        auto *bwt = new unsigned char[n];
+        for (usize_t i = 0; i < n; i++)
+            in[i] = static_cast<unsigned char>(raw_data.data[i]);
+
+        transform_result result;
+        result.primary = detail::huffman_bwt(in, bwt, n);
+        detail::huffman_mtf(bwt, n);
+        result.size = detail::huffman_rle(bwt, n, result.data.data());
+
+        delete[] in;
+        delete[] bwt;
+        return result;
+    }
+
+    constexpr static auto result = transform();
+    constexpr static auto transformed =
+        detail::huffman_make_container<result.size>(result.data.data());
+    constexpr static auto primary = result.primary;
+
+public:
+    using value_type = std::remove_cvref_t<decltype(raw_data.data[0])>;
+    using compressor = huffman_compressor<transformed>;
+
+    consteval huffman_bwt_compressor() noexcept = default;
+
+    consteval static auto compressed_size() noexcept {
+        return detail::huffman_stored_size<compressor>();
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return raw_data.size();
+    }
+
+    /**
+     * Decompresses all of the data.
+     * @param out Where to store the data; must hold uncompressed_size().
+     */
+    void decode(std::span<value_type> out) const {
+        auto n = uncompressed_size();
+        auto buffer = std::make_unique<unsigned char[]>(transformed.size() + n);
+        auto *rle = buffer.get();
+        auto *mtf = rle + transformed.size();
+
+        std::copy(data.begin(), data.end(), rle);
+        detail::huffman_inverse_rle(rle, transformed.size(), mtf);
+        detail::huffman_inverse_mtf(mtf, n);
+        detail::huffman_inverse_bwt(mtf, reinterpret_cast<unsigned char *>(out.data()),
+            n, primary);
+    }
+
+    // The Huffman coded, transformed data.
+    compressor data;
+};
+
+template <detail::huffman_string_container hsc>
+constexpr auto huffman_compress_bwt = huffman_bwt_compressor<hsc>();
+
+/**
+ * Compresses the given data with Huffman coding, first run-length encoding
+ * it if that gives a smaller result. Long runs are common in binary tables
+ * (bitmaps, zero padding), and cost at least one bit per value when only
+ * Huffman coded; run-length encoding stores them in three values.
+ * @tparam raw_data The data to be compressed.
+ */
+template<auto raw_data>
+    requires(raw_data.size() > 0)
+class huffman_rle_compressor
+{
+    using usize_t = unsigned long int;
+
+    struct rle_result {
+        // Run-length encoding expands data by at most half, when every run
+        // is two values long (each becomes three)
+        std::array<unsigned char, raw_data.size() * 3 / 2 + 1> data {};
+        usize_t size = 0;
+    };
+
+    consteval static auto encode() noexcept {
+        auto n = raw_data.size();
+        auto *in = new unsigned char[n];
+        for (usize_t i = 0; i < n; i++)
+            in[i] = static_cast<unsigned char>(raw_data.data[i]);
+
+        rle_result result;
+        result.size = detail::huffman_rle(in, n, result.data.data());
+        delete[] in;
+        return result;
+    }
+
+    constexpr static auto result = encode();
+    constexpr static auto encoded =
+        detail::huffman_make_container<result.size>(result.data.data());
+
+    using plain_compressor = huffman_compressor<raw_data>;
+    using rle_compressor = huffman_compressor<encoded>;
+
+public:
+    using value_type = std::remove_cvref_t<decltype(raw_data.data[0])>;
+
+    // True if the data is stored run-length encoded.
+    constexpr static bool uses_rle = detail::huffman_stored_size<rle_compressor>() <
+        detail::huffman_stored_size<plain_compressor>();
+
+    using compressor = std::conditional_t<uses_rle, rle_compressor, plain_compressor>;
+
+    // Iterates over the data, expanding runs.
+    class decoder {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = int;
+
+        decoder() = default;
+        decoder(typename compressor::decoder begin,
+            typename compressor::decoder end) noexcept
+            : m_next(begin), m_end(end) { get_next(); }
+
+        bool operator==(const decoder& other) const noexcept {
+            return m_next == other.m_next &&
+                m_repeat == other.m_repeat &&
+                m_current == other.m_current;
+        }
+        auto operator*() const noexcept {
+            return m_current;
+        }
+        decoder& operator++() noexcept {
+            if (m_repeat > 0)
+                m_repeat--;
+            else
+                get_next();
+            return *this;
+        }
+        decoder operator++(int) noexcept {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+    private:
+        void get_next() noexcept {
+            if (m_next == m_end) {
+                m_current = -1;
+                return;
+            }
+
+            auto last = std::exchange(m_current, *m_next++);
+            if (m_current == last && !m_after_run) {
+                m_repeat = *m_next++;
+                m_after_run = true;
+            } else {
+                m_after_run = false;
+            }
+        }
+
+        typename compressor::decoder m_next;
+        typename compressor::decoder m_end;
+        int m_current = -1;
+        int m_repeat = 0;
+        bool m_after_run = false;
+    };
+
+    consteval huffman_rle_compressor() noexcept = default;
+
+    consteval static auto compressed_size() noexcept {
+        return detail::huffman_stored_size<compressor>();
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return raw_data.size();
+    }
+
+    auto begin() const noexcept {
+        if constexpr (uses_rle)
+            return decoder(data.begin(), data.end());
+        else
+            return data.begin();
+    }
+    auto end() const noexcept {
+        if constexpr (uses_rle)
+            return decoder(data.end(), data.end());
+        else
+            return data.end();
+    }
+    auto cbegin() const noexcept { return begin(); }
+    auto cend() const noexcept { return end(); }
+
+    /**
+     * Decompresses all of the data, filling runs with memset.
+     * @param out Where to store the data; must hold uncompressed_size().
+     */
+    void decode(std::span<value_type> out) const noexcept {
+        auto *o = reinterpret_cast<unsigned char *>(out.data());
+        if constexpr (uses_rle) {
+            int last = -1;
+            for (auto it = data.begin(), e = data.end(); it != e;) {
+                auto c = *it++;
+                *o++ = static_cast<unsigned char>(c);
+                if (c == last) {
+                    auto count = *it++;
+                    std::memset(o, c, count);
+                    o += count;
+                    last = -1;
+                } else {
+                    last = c;
+                }
+            }
+        } else {
+            std::copy(data.begin(), data.end(), o);
+        }
+    }
+
+    // The Huffman coded (and possibly run-length encoded) data.
+    compressor data;
+};
+
+template <detail::huffman_string_container hsc>
+constexpr auto huffman_compress_rle = huffman_rle_compressor<hsc>();
+
+/**
+ * A reversible filter that replaces each value with its difference from an
+ * earlier value. Smooth or monotonic numeric data becomes a few small,
+ * repetitive values, which compress far better.
+ */
+struct huffman_filter {
+    enum kind_type : unsigned char {
+        none,
+        delta,       // Subtract the earlier value (modulo 256)
+        xor_previous // Exclusive-or with the earlier value
+    };
+
+    kind_type kind = none;
+    // Distance to the earlier value. For arrays of packed structs, use the
+    // struct's size to take differences between matching fields.
+    unsigned int stride = 1;
+};
+
+/**
+ * Compresses the given data after applying a huffman_filter, with
+ * run-length encoding when it helps (see huffman_rle_compressor).
+ * @tparam raw_data The data to be compressed.
+ * @tparam filter The filter to apply.
+ */
+template<auto raw_data, huffman_filter filter>
+    requires(raw_data.size() > 0 && filter.stride > 0)
+class huffman_filtered_compressor
+{
+    using usize_t = unsigned long int;
+
+    consteval static auto apply_filter() noexcept {
+        unsigned char filtered[raw_data.size()] = {};
+        for (usize_t i = 0; i < raw_data.size(); i++) {
+            auto c = static_cast<unsigned char>(raw_data.data[i]);
+            auto prev = i >= filter.stride
+                ? static_cast<unsigned char>(raw_data.data[i - filter.stride]) : 0;
+            if constexpr (filter.kind == huffman_filter::delta)
+                c -= prev;
+            else if constexpr (filter.kind == huffman_filter::xor_previous)
+                c ^= prev;
+            filtered[i] = c;
+        }
+        return detail::huffman_string_container(filtered);
+    }
+
+    constexpr static auto filtered = apply_filter();
+
+public:
+    using value_type = std::remove_cvref_t<decltype(raw_data.data[0])>;
+    using compressor = huffman_rle_compressor<filtered>;
+
+    consteval huffman_filtered_compressor() noexcept = default;
+
+    consteval static auto compressed_size() noexcept {
+        return compressor::compressed_size();
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return raw_data.size();
+    }
+
+    /**
+     * Decompresses all of the data and reverses the filter.
+     * @param out Where to store the data; must hold uncompressed_size().
+     */
+    void decode(std::span<value_type> out) const noexcept {
+        auto *o = reinterpret_cast<unsigned char *>(out.data());
+        data.decode(std::span(o, out.size()));
+
+        constexpr auto n = raw_data.size();
+        if constexpr (filter.kind == huffman_filter::delta && filter.stride == 1) {
+            detail::huffman_inverse_delta(o, n);
+        } else if constexpr (filter.kind == huffman_filter::xor_previous && filter.stride == 1) {
+            detail::huffman_inverse_xor(o, n);
+        } else if constexpr (filter.kind == huffman_filter::delta) {
+            for (usize_t i = filter.stride; i < n; i++)
+                o[i] = static_cast<unsigned char>(o[i] + o[i - filter.stride]);
+        } else if constexpr (filter.kind == huffman_filter::xor_previous) {
+            for (usize_t i = filter.stride; i < n; i++)
+                o[i] ^= o[i - filter.stride];
+        }
+    }
+
+    // The Huffman coded, filtered data.
+    compressor data;
+};
+
+namespace detail
+{
+    template <huffman_filter filter, typename T, T... list>
+    class huffman_compress_array_filtered_container {
+    private:
+        constexpr static T uncompressed[] = {list...};
+    public:
+        constexpr static auto data = huffman_filtered_compressor<
+            huffman_string_container(uncompressed), filter>();
+    };
+}
+template <huffman_filter filter, typename T, T... list>
+constexpr auto huffman_compress_array_filtered =
+    detail::huffman_compress_array_filtered_container<filter, T, list...>::data;
+
+/**
+ * Compresses an array of multi-byte integers as byte planes: all of the
+ * lowest bytes, then all of the second bytes, and so on. High bytes of small
+ * or slowly changing integers then form long runs for the run-length
+ * encoder, rather than being scattered between the low bytes.
+ * @tparam T The integer type, wider than one byte.
+ * @tparam list The integers to compress.
+ */
+template <typename T, T... list>
+    requires(std::integral<T> && sizeof(T) > 1 && sizeof...(list) > 0)
+class huffman_planar_compressor
+{
+    using usize_t = unsigned long int;
+
+    constexpr static usize_t count = sizeof...(list);
+
+public:
+    using value_type = T;
+    using compressor = huffman_rle_compressor<
+        detail::huffman_byte_split_container<true, T, list...>::data>;
+
+    /**
+     * Iterates over the integers, reading one byte from each plane per step.
+     * Creating the iterator skips through every plane but the last to find
+     * where each one starts, so prefer decode() to read all of the data.
+     */
+    class decoder {
+        using plane_decoder = decltype(std::declval<const compressor&>().begin());
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        decoder() = default;
+        decoder(plane_decoder first, usize_t remaining) noexcept
+            : m_remaining(remaining)
+        {
+            for (usize_t b = 0; b < sizeof(T); b++) {
+                m_planes[b] = first;
+                for (usize_t i = 0; b + 1 < sizeof(T) && i < count; i++)
+                    ++first;
+            }
+            get_next();
+        }
+
+        bool operator==(const decoder& other) const noexcept {
+            return m_remaining == other.m_remaining;
+        }
+        auto operator*() const noexcept {
+            return m_current;
+        }
+        decoder& operator++() noexcept {
+            m_remaining--;
+            get_next();
+            return *this;
+        }
+        decoder operator++(int) noexcept {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+    private:
+        void get_next() noexcept {
+            if (m_remaining == 0)
+                return;
+
+            std::make_unsigned_t<T> v = 0;
+            for (usize_t b = 0; b < sizeof(T); b++) {
+                auto byte = static_cast<unsigned char>(*m_planes[b]);
+                ++m_planes[b];
+                v |= static_cast<std::make_unsigned_t<T>>(byte) << (b * 8);
+            }
+            m_current = static_cast<T>(v);
+        }
+
+        std::array<plane_decoder, sizeof(T)> m_planes {};
+        usize_t m_remaining = 0;
+        T m_current = 0;
+    };
+
+    consteval huffman_planar_compressor() noexcept = default;
+
+    consteval static auto compressed_size() noexcept {
+        return compressor::compressed_size();
+    }
+    consteval static auto uncompressed_size() noexcept {
+        return count * sizeof(T);
+    }
+
+    // Returns the number of integers.
+    constexpr static auto size() noexcept {
+        return count;
+    }
+
+    auto begin() const noexcept {
+        return decoder(data.begin(), count);
+    }
+    auto end() const noexcept {
+        return decoder();
+    }
+    auto cbegin() const noexcept { return begin(); }
+    auto cend() const noexcept { return end(); }
+
+    /**
+     * Decompresses all of the integers, gathering each from the planes.
+     * @param out Where to store the integers; must hold size().
+     */
+    void decode(std::span<T> out) const noexcept {
+        using unsigned_type = std::make_unsigned_t<T>;
+        std::fill(out.begin(), out.end(), T(0));
+
+        auto it = data.begin();
+        for (usize_t b = 0; b < sizeof(T); b++) {
+            for (auto& v : out) {
+                auto byte = static_cast<unsigned_type>(
+                    static_cast<unsigned char>(*it++));
+                v = static_cast<T>(static_cast<unsigned_type>(v) | byte << (b * 8));
+            }
+        }
+    }
+
+    // The Huffman coded (and possibly run-length encoded) planes.
+    compressor data;
+};
+
+namespace detail
+{
+    template <typename T, T... list>
+    class huffman_compress_array_rle_container {
+    private:
+        constexpr static T uncompressed[] = {list...};
+    public:
+        constexpr static auto data = huffman_compress_rle<uncompressed>;
+    };
+
+    template <typename T, T... list>
+        requires(sizeof(T) > 1)
+    class huffman_compress_array_rle_container<T, list...> {
+    public:
+        constexpr static auto data = huffman_planar_compressor<T, list...>();
+    };
+}
+template <typename T, T... list>
+constexpr auto huffman_compress_array_rle =
+    detail::huffman_compress_array_rle_container<T, list...>::data;
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_TRANSFORM_HPP_
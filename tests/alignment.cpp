@@ -0,0 +1,29 @@
+/**
+ * alignment.cpp - Decodes literals with aligned payloads and trees.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#include <cstdint>
+
+#define LINE "she sells sea shells by the sea shore. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE
+
+constexpr auto words = huffman_compress<TEXT, {.alignment = 8}>;
+constexpr auto lines = huffman_compress<TEXT, {.alignment = 64, .tree_alignment = 64}>;
+
+int main()
+{
+    static_assert(words.bytes_saved() > 0 && lines.bytes_saved() > 0);
+    check(equals(words, literal(TEXT)), "8-byte alignment");
+    check(equals(lines, literal(TEXT)), "64-byte alignment");
+    check(reinterpret_cast<std::uintptr_t>(words.data()) % 8 == 0, "data() is aligned");
+    check(reinterpret_cast<std::uintptr_t>(lines.data()) % 64 == 0 &&
+        reinterpret_cast<std::uintptr_t>(lines.decode_tree()) % 64 == 0,
+        "data() and the tree are aligned");
+    static_assert(lines.layout().tree_offset % 64 == 0);
+
+    return report();
+}
@@ -0,0 +1,50 @@
+/**
+ * arrays.cpp - Round-trips arrays of integers wider than a byte, both as
+ * interleaved bytes and as byte planes.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/transform.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+template<typename T, T... list>
+static void check_array(const char *what)
+{
+    constexpr T expected[] = {list...};
+
+    constexpr auto wide = huffman_compress_array<T, list...>;
+    static_assert(std::input_iterator<decltype(wide.begin())>);
+    check(std::ranges::equal(wide, expected), what);
+    T out[sizeof...(list)];
+    wide.decode(out);
+    check(std::ranges::equal(out, expected), what);
+
+    constexpr auto planes = huffman_compress_array_rle<T, list...>;
+    static_assert(std::input_iterator<decltype(planes.begin())>);
+    static_assert(std::same_as<decltype(*planes.begin()), T>);
+    check(std::ranges::equal(planes, expected), what);
+    std::fill(std::begin(out), std::end(out), T(0));
+    planes.decode(out);
+    check(std::ranges::equal(out, expected), what);
+}
+
+int main()
+{
+    check_array<std::uint16_t, 1, 2, 3, 4, 5, 6, 7, 8, 9, 1000, 65535>("uint16_t");
+    check_array<std::int32_t, -1, 100000, 3, 3, 3, 3, 3, 3, -2147483647 - 1>("int32_t");
+    check_array<std::uint64_t, 1, 0xFFFFFFFFFFFFFFFF, 2, 3, 0x0123456789ABCDEF>("uint64_t");
+    check_array<std::int16_t, 7>("one value");
+
+    // Small values leave the high-byte plane as one long run
+    constexpr auto small = huffman_compress_array_rle<std::uint32_t, 1, 2, 3, 4, 5, 6, 7, 8,
+        9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30>;
+    static_assert(small.compressed_size() <
+        huffman_compress_array<std::uint32_t, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+            15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30>.compressed_size());
+
+    return report();
+}
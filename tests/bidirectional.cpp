@@ -0,0 +1,44 @@
+/**
+ * bidirectional.cpp - Decodes literals backwards from end().
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#include <algorithm>
+
+#define LINE "she sells sea shells by the sea shore. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE
+
+template<const auto& data>
+static void check_backwards(std::string_view expected, const char *what)
+{
+    std::string backwards;
+    for (auto it = data.end(); it != data.begin();)
+        backwards += *--it;
+    check(std::equal(backwards.rbegin(), backwards.rend(), expected.begin(), expected.end()),
+        what);
+
+    // Turning back part-way must retrace the same values
+    auto it = data.begin();
+    for (std::size_t i = 0; i < expected.size() - 1; i++)
+        ++it;
+    for (std::size_t i = 0; i < expected.size() / 2; i++)
+        --it;
+    check(*it == expected[expected.size() - 1 - expected.size() / 2], what);
+}
+
+constexpr auto coded = huffman_compress<TEXT, {.bidirectional = true}>;
+constexpr auto raw = huffman_compress<"abc", {.bidirectional = true}>;
+
+int main()
+{
+    static_assert(coded.bytes_saved() > 0 && raw.bytes_saved() == 0);
+    static_assert(std::bidirectional_iterator<decltype(coded.begin())>);
+    check(equals(coded, literal(TEXT)), "bidirectional, forwards");
+    check_backwards<coded>(literal(TEXT), "bidirectional, backwards");
+    check_backwards<raw>(literal("abc"), "bidirectional, uncompressed");
+
+    return report();
+}
@@ -0,0 +1,33 @@
+/**
+ * bwt.cpp - Round-trips literals through the Burrows-Wheeler transform.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/transform.hpp>
+
+#define LINE "Compression needs some repetition to be worthwhile; so does this. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE
+
+template<const auto& data>
+static std::string decode()
+{
+    std::string out (data.uncompressed_size(), '\0');
+    data.decode(out);
+    return out;
+}
+
+constexpr auto text = huffman_compress_bwt<TEXT>;
+constexpr auto pairs = huffman_compress_bwt<"aabbccddeeffgghhiijjkkllmmnnoo">;
+constexpr auto one = huffman_compress_bwt<"x">;
+
+int main()
+{
+    static_assert(text.compressed_size() < huffman_compress<TEXT>.compressed_size());
+    check(decode<text>() == literal(TEXT), "huffman_compress_bwt");
+    check(decode<pairs>() == literal("aabbccddeeffgghhiijjkkllmmnnoo"),
+        "huffman_compress_bwt of pairs");
+    check(decode<one>() == literal("x"), "huffman_compress_bwt of one value");
+
+    return report();
+}
@@ -0,0 +1,36 @@
+/**
+ * cache.cpp - Iterates literals through the decoded() cache, and checks the
+ * storage presets.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#define LINE "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbcccccccccd "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE
+
+constexpr auto cached = huffman_compress<TEXT, {.cache_decoded = true}>;
+constexpr auto hot = huffman_compress<TEXT, huffman_hot>;
+constexpr auto hot_raw = huffman_compress<"she sells sea shells", huffman_hot>;
+constexpr auto balanced = huffman_compress<TEXT, huffman_balanced>;
+constexpr auto cold = huffman_compress<TEXT, huffman_cold>;
+
+int main()
+{
+    static_assert(cached.bytes_saved() > 0 && hot.bytes_saved() > 0 &&
+        balanced.bytes_saved() > 0 && cold.bytes_saved() > 0);
+    static_assert(hot_raw.bytes_saved() == 0);
+
+    // Cached iteration walks the decoded() buffer, unless the data is raw
+    // and can be read in place
+    static_assert(std::same_as<decltype(cached.begin()), decltype(cached.decoded().begin())>);
+    static_assert(!std::same_as<decltype(hot_raw.begin()), decltype(hot_raw.decoded().begin())>);
+    check(equals(cached, literal(TEXT)), "cache_decoded");
+    check(equals(hot_raw, literal("she sells sea shells")), "huffman_hot, raw");
+
+    check(equals(hot, literal(TEXT)) && equals(balanced, literal(TEXT)) &&
+        equals(cold, literal(TEXT)), "presets");
+
+    return report();
+}
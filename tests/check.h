@@ -0,0 +1,46 @@
+/**
+ * check.h - Minimal checking helpers shared by the tests.
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_TESTS_CHECK_H_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_TESTS_CHECK_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+inline int failures = 0;
+
+inline void check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// True if the range holds exactly the expected characters.
+template<typename R>
+bool equals(const R& range, std::string_view expected)
+{
+    return std::string(range.begin(), range.end()) == expected;
+}
+
+// Views a string literal with its terminating null, as huffman_compress
+// stores it.
+template<std::size_t N>
+constexpr std::string_view literal(const char (&s)[N])
+{
+    return {s, N};
+}
+
+// Prints the outcome; returns main()'s exit code.
+inline int report()
+{
+    if (failures == 0)
+        std::puts("passed");
+    return failures == 0 ? 0 : 1;
+}
+
+#endif // TCSULLIVAN_CONSTEVAL_HUFFMAN_TESTS_CHECK_H_
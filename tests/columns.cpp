@@ -0,0 +1,58 @@
+/**
+ * columns.cpp - Compresses an array of structs field by field, and reads
+ * the fields back together or one column at a time.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/columns.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+struct point {
+    std::uint8_t id;
+    std::uint16_t x, y;
+    std::int32_t z;
+};
+
+constexpr auto make_points() noexcept
+{
+    std::array<point, 64> points {};
+    for (int i = 0; i < 64; i++) {
+        points[i] = {static_cast<std::uint8_t>(i / 16), static_cast<std::uint16_t>(100 + i % 4),
+            static_cast<std::uint16_t>(i < 60 ? 200 : 65535), i % 3 - 1};
+    }
+    return points;
+}
+
+constexpr auto points = make_points();
+constexpr auto table = huffman_compress_columns<points, &point::id, &point::x, &point::y,
+    &point::z>;
+
+static bool same(const point& a, const point& b)
+{
+    return a.id == b.id && a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+int main()
+{
+    static_assert(table.size() == points.size());
+    static_assert(table.compressed_size() < table.uncompressed_size() / 2);
+
+    std::vector<point> rows (table.begin(), table.end());
+    check(std::ranges::equal(rows, points, same), "huffman_compress_columns");
+
+    // One column can be read without the others
+    check(std::ranges::equal(table.column<1>(), points, {}, {}, &point::x), "column<1>()");
+    check(std::ranges::equal(table.column<3>(), points, {}, {}, &point::z), "column<3>()");
+    std::uint16_t ys[points.size()];
+    table.decode_column<2>(ys);
+    check(std::ranges::equal(ys, points, {}, {}, &point::y), "decode_column<2>()");
+    static_assert(table.column_size<0>() + table.column_size<1>() + table.column_size<2>() +
+        table.column_size<3>() == table.compressed_size());
+
+    return report();
+}
@@ -0,0 +1,88 @@
+/**
+ * decode_all_bench.cpp - Times decode_all() over a set of literals, as at
+ * program start-up, with one thread and then with more threads up to the
+ * core count (and at least two). Each run's output is checked against the
+ * single-threaded one.
+ */
+
+#include <consteval_huffman/parallel.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Builds one to three KB of pseudo-random words, so that literals vary in
+// size as they would in a real program.
+template<int seed>
+consteval auto make_text() noexcept
+{
+    constexpr std::string_view words[] = {"start ", "up ", "decode ", "the ",
+        "literal ", "thread ", "pool ", "arena ", "of ", "bytes ", "and ", "a "};
+
+    char text[1024 + 512 * seed] = {};
+    unsigned int state = 2463534242u + seed;
+    for (std::size_t i = 0; i + 1 < sizeof(text);) {
+        state ^= state << 13, state ^= state >> 17, state ^= state << 5;
+        for (auto c : words[state % std::size(words)]) {
+            if (i + 1 < sizeof(text))
+                text[i++] = c;
+        }
+    }
+    return detail::huffman_string_container(text);
+}
+
+template<int seed>
+constexpr auto data = huffman_compress<make_text<seed>()>;
+
+// Compiling literals is slow, so each one is decoded by several jobs.
+template<int... seeds>
+static auto make_jobs(std::integer_sequence<int, seeds...>, int copies)
+{
+    std::vector<huffman_decode_job> jobs;
+    for (int i = 0; i < copies; i++)
+        (jobs.emplace_back(data<seeds>), ...);
+    return jobs;
+}
+
+int main()
+{
+    constexpr int runs = 20;
+    auto jobs = make_jobs(std::make_integer_sequence<int, 5>(), 32);
+
+    std::size_t total = 0;
+    for (const auto& job : jobs)
+        total += job.size;
+    std::vector<unsigned char> expected (total), arena (total);
+    decode_all(jobs, expected, 1);
+
+    auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    auto max_threads = std::max(cores, 2u);
+    std::printf("%zu jobs, %zu bytes, %u cores\n", jobs.size(), total, cores);
+
+    int failures = 0;
+    double single = 0;
+    for (unsigned int threads = 1; threads <= max_threads;
+        threads = threads < max_threads ? std::min(threads * 2, max_threads) : threads + 1)
+    {
+        auto best = std::chrono::duration<double>::max();
+        for (int i = 0; i < runs; i++) {
+            std::fill(arena.begin(), arena.end(), 0);
+            auto start = std::chrono::steady_clock::now();
+            decode_all(jobs, arena, threads);
+            best = std::min(best, std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start));
+            failures += arena != expected;
+        }
+
+        auto ms = best.count() * 1e3;
+        if (threads == 1)
+            single = ms;
+        std::printf("%3u threads: %8.3f ms (%.1fx)\n", threads, ms, single / ms);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
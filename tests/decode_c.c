@@ -0,0 +1,38 @@
+/**
+ * decode_c.c - Decodes the literals from decode_c_export.cpp with the C99
+ * decoder in decode.h, and checks that it matches the C++ iterator.
+ */
+
+#include "decode_c.h"
+
+#include <consteval_huffman/decode.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(void)
+{
+    int failures = 0;
+    size_t i;
+
+    for (i = 0; i < exported_literal_count(); i++) {
+        struct exported_literal e = exported_literal_get(i);
+        unsigned char *out = malloc(e.values + 1);
+
+        if (e.compressed)
+            huffman_decode(e.data + e.payload_offset, e.tree, e.values, out);
+        else
+            memcpy(out, e.data, e.values);
+
+        if (memcmp(out, e.expected, e.values) != 0) {
+            printf("FAIL: %s\n", e.name);
+            failures++;
+        }
+        free(out);
+    }
+
+    printf("%d failures over %lu literals\n", failures,
+        (unsigned long)exported_literal_count());
+    return failures == 0 ? 0 : 1;
+}
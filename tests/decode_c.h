@@ -0,0 +1,31 @@
+/**
+ * decode_c.h - Literals exported from C++ for the C99 decoder test.
+ */
+
+#ifndef TCSULLIVAN_CONSTEVAL_HUFFMAN_TESTS_DECODE_C_H_
+#define TCSULLIVAN_CONSTEVAL_HUFFMAN_TESTS_DECODE_C_H_
+
+#include <stddef.h>
+
+struct exported_literal {
+    const char *name;
+    int compressed;
+    const unsigned char *data;      /* data() */
+    size_t payload_offset;          /* layout().payload_offset */
+    const unsigned char *tree;      /* decode_tree() */
+    size_t values;                  /* layout().values */
+    const unsigned char *expected;  /* What the C++ iterator decodes */
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t exported_literal_count(void);
+struct exported_literal exported_literal_get(size_t i);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCSULLIVAN_CONSTEVAL_HUFFMAN_TESTS_DECODE_C_H_ */
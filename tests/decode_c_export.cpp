@@ -0,0 +1,57 @@
+/**
+ * decode_c_export.cpp - Exports compressed literals, and their decoding by
+ * the C++ iterator, to decode_c.c.
+ */
+
+#include "decode_c.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#define LINE "export it, then decode it; decode it, then export it. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE
+#define HIGH "\xff\xfe\xff\x80\x80\x80\x80\x00\x00\x01\xff\xff\xff\xff\xff"
+
+constexpr auto plain = huffman_compress<TEXT>;
+constexpr auto separate = huffman_compress<TEXT, {.separate_tree = true, .tree_alignment = 64}>;
+constexpr auto aligned = huffman_compress<TEXT, {.alignment = 8}>;
+constexpr auto modelled = huffman_compress<"decode it", {.separate_tree = true,
+    .frequencies = huffman_frequencies_of<TEXT>}>;
+constexpr auto high = huffman_compress<HIGH HIGH HIGH HIGH HIGH HIGH>;
+constexpr auto raw = huffman_compress<"raw">;
+
+static_assert(plain.bytes_saved() > 0 && separate.bytes_saved() > 0 &&
+    aligned.bytes_saved() > 0 && modelled.bytes_saved() > 0 && high.bytes_saved() > 0);
+
+template<const auto& literal>
+static exported_literal make_export(const char *name)
+{
+    // Decoded once, by the C++ iterator, for the C decoder to match
+    static const auto expected = std::vector<unsigned char>(literal.begin(), literal.end());
+
+    constexpr auto layout = literal.layout();
+    exported_literal e {name, layout.compressed, literal.data(), layout.payload_offset,
+        nullptr, literal.uncompressed_size(), expected.data()};
+    if constexpr (layout.compressed)
+        e.tree = literal.decode_tree();
+    return e;
+}
+
+extern "C" size_t exported_literal_count(void)
+{
+    return 6;
+}
+
+extern "C" exported_literal exported_literal_get(size_t i)
+{
+    switch (i) {
+    case 0: return make_export<plain>("plain");
+    case 1: return make_export<separate>("separate_tree");
+    case 2: return make_export<aligned>("aligned");
+    case 3: return make_export<modelled>("frequencies");
+    case 4: return make_export<high>("high values");
+    default: return make_export<raw>("uncompressed");
+    }
+}
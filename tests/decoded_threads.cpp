@@ -0,0 +1,72 @@
+/**
+ * decoded_threads.cpp - Calls decoded() from 64 threads at once and checks
+ * that every thread sees the same, fully decompressed data.
+ */
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#define TEXT "Any number of threads may call decoded() concurrently: the first " \
+             "caller decompresses while the others wait on the cache's state " \
+             "flag, and all later calls are a single acquire load. "
+
+constexpr std::string_view text {TEXT TEXT TEXT TEXT, sizeof(TEXT TEXT TEXT TEXT)};
+
+// A fresh literal per round, so that every round starts with a cold cache.
+template<int round>
+constexpr auto data = huffman_compress<TEXT TEXT TEXT TEXT, {.min_saved_bytes = round}>;
+
+template<int round>
+static int run_round(unsigned int thread_count)
+{
+    static_assert(data<round>.bytes_saved() > 0);
+
+    std::atomic<unsigned int> ready = 0;
+    std::atomic<int> failures = 0;
+    std::atomic<const char *> shared = nullptr;
+
+    auto worker = [&] {
+        // Spin until every thread is running, so that they collide
+        ready.fetch_add(1);
+        while (ready.load() < thread_count)
+            std::this_thread::yield();
+
+        auto view = data<round>.decoded();
+        const char *expected = nullptr;
+        shared.compare_exchange_strong(expected, view.data());
+        if (!std::equal(view.begin(), view.end(), text.begin(), text.end()) ||
+            view.data() != shared.load())
+        {
+            failures++;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < thread_count; i++)
+        threads.emplace_back(worker);
+    for (auto& t : threads)
+        t.join();
+
+    if (data<round>.decoded().data() != shared.load())
+        failures++;
+    return failures;
+}
+
+template<int... rounds>
+static int run_rounds(std::integer_sequence<int, rounds...>)
+{
+    return (run_round<rounds + 1>(64) + ...);
+}
+
+int main()
+{
+    auto failures = run_rounds(std::make_integer_sequence<int, 8>());
+    std::printf("%d failures over 8 rounds of 64 threads\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,61 @@
+/**
+ * deflate.cpp - Inflates streams from huffman_compress_deflate with zlib.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/deflate.hpp>
+
+#include <zlib.h>
+
+#include <vector>
+
+using format = huffman_deflate_options::format_type;
+
+static std::string zlib_inflate(std::span<const unsigned char> in, format f, std::size_t size)
+{
+    z_stream z {};
+    inflateInit2(&z, f == huffman_deflate_options::raw ? -15 :
+        f == huffman_deflate_options::zlib ? 15 : 15 + 16);
+    std::string out (size + 1, '\0');
+    z.next_in = const_cast<unsigned char *>(in.data());
+    z.avail_in = static_cast<uInt>(in.size());
+    z.next_out = reinterpret_cast<unsigned char *>(out.data());
+    z.avail_out = static_cast<uInt>(out.size());
+    auto result = inflate(&z, Z_FINISH);
+    out.resize(result == Z_STREAM_END ? z.total_out : 0);
+    inflateEnd(&z);
+    return out;
+}
+
+#define LINE "<tr><td class=\"name\">sensor</td><td class=\"value\">3.14</td></tr>\n"
+#define PAGE "<html><body><table>\n" LINE LINE LINE LINE LINE LINE "</table></body></html>\n"
+
+template<const auto& stream>
+static void check_stream(std::string_view expected, format f, const char *what)
+{
+    check(zlib_inflate(stream.bytes(), f, expected.size()) == expected, what);
+    auto crc = crc32(0, reinterpret_cast<const Bytef *>(expected.data()),
+        static_cast<uInt>(expected.size()));
+    check(stream.crc32() == crc, "crc32()");
+}
+
+constexpr auto gzip = huffman_compress_deflate<PAGE>;
+constexpr auto zlib = huffman_compress_deflate<PAGE, {huffman_deflate_options::zlib}>;
+constexpr auto raw = huffman_compress_deflate<PAGE, {huffman_deflate_options::raw}>;
+constexpr auto no_lz77 = huffman_compress_deflate<PAGE, {huffman_deflate_options::raw, false}>;
+constexpr auto one = huffman_compress_deflate<"x", {huffman_deflate_options::zlib}>;
+
+int main()
+{
+    constexpr std::string_view page = PAGE;
+    check(gzip.size() < page.size() / 2 && no_lz77.size() < page.size(), "streams compress");
+
+    check_stream<gzip>(page, huffman_deflate_options::gzip, "gzip");
+    check_stream<zlib>(page, huffman_deflate_options::zlib, "zlib");
+    check_stream<raw>(page, huffman_deflate_options::raw, "raw DEFLATE");
+    check_stream<no_lz77>(page, huffman_deflate_options::raw, "raw DEFLATE without LZ77");
+    check_stream<one>("x", huffman_deflate_options::zlib, "one byte");
+
+    return report();
+}
@@ -0,0 +1,66 @@
+/**
+ * encoded.cpp - Passes stored bytes on with encoded() and decodes them
+ * elsewhere.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+#include <consteval_huffman/deflate.hpp>
+#include <consteval_huffman/inflate.hpp>
+
+#include <vector>
+
+#define LINE "she sells sea shells by the sea shore. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE
+
+constexpr auto coded = huffman_compress<TEXT>;
+constexpr auto separate = huffman_compress<TEXT, {.separate_tree = true}>;
+constexpr auto raw = huffman_compress<"raw">;
+constexpr auto gzip = huffman_compress_deflate<TEXT>;
+
+// Decodes a huffman-encoded payload, as a receiver holding only the bytes,
+// the tree and the size would.
+static std::string decode(const huffman_encoded& e, std::size_t payload_offset,
+    std::size_t tree_offset)
+{
+    auto *payload = reinterpret_cast<const unsigned char *>(e.bytes.data()) + payload_offset;
+    auto *tree = reinterpret_cast<const unsigned char *>(
+        e.tree.empty() ? e.bytes.data() + tree_offset : e.tree.data());
+
+    std::string out;
+    unsigned char bit = 0x80, length;
+    for (unsigned long int i = 0; i < e.uncompressed_size; i++)
+        out += static_cast<char>(detail::huffman_decode_one(tree, payload, bit, length));
+    return out;
+}
+
+int main()
+{
+    static_assert(coded.bytes_saved() > 0 && separate.bytes_saved() > 0 &&
+        raw.bytes_saved() == 0);
+
+    auto e = coded.encoded();
+    check(e.encoding == huffman_encoded::huffman && e.tree.empty() &&
+        e.bytes.size() == coded.size(), "encoded()");
+    check(decode(e, coded.layout().payload_offset, coded.layout().tree_offset) == literal(TEXT),
+        "decoding encoded() bytes");
+
+    auto s = separate.encoded();
+    check(s.encoding == huffman_encoded::huffman && !s.tree.empty(), "encoded() with a tree");
+    check(decode(s, separate.layout().payload_offset, 0) == literal(TEXT),
+        "decoding encoded() bytes with a separate tree");
+
+    auto r = raw.encoded();
+    check(r.encoding == huffman_encoded::identity &&
+        equals(std::span(reinterpret_cast<const char *>(r.bytes.data()), r.bytes.size()),
+            literal("raw")), "encoded() of raw data");
+
+    auto g = gzip.encoded();
+    std::vector<unsigned char> out (g.uncompressed_size);
+    check(g.encoding == huffman_encoded::gzip && equals(huffman_inflate(std::span(
+        reinterpret_cast<const unsigned char *>(g.bytes.data()), g.bytes.size()), out),
+        TEXT), "encoded() of a gzip stream");
+
+    return report();
+}
@@ -0,0 +1,39 @@
+/**
+ * filter.cpp - Round-trips numeric arrays through the delta and XOR filters.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/transform.hpp>
+
+#include <algorithm>
+
+template<huffman_filter filter, unsigned char... list>
+static void check_filter(const char *what)
+{
+    constexpr auto data = huffman_compress_array_filtered<filter, unsigned char, list...>;
+    constexpr unsigned char expected[] = {list...};
+    unsigned char out[sizeof...(list)];
+    data.decode(out);
+    check(std::ranges::equal(out, expected), what);
+}
+
+int main()
+{
+    check_filter<huffman_filter{huffman_filter::delta},
+        10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30, 32, 34, 36, 38, 40>("delta filter");
+    check_filter<huffman_filter{huffman_filter::delta, 2},
+        1, 100, 2, 98, 3, 96, 4, 94, 5, 92, 6, 90, 7, 88>("delta filter, stride 2");
+    check_filter<huffman_filter{huffman_filter::xor_previous},
+        0xF0, 0xF1, 0xF0, 0xF1, 0xF0, 0xF1, 0xF0, 0xF1>("XOR filter");
+    check_filter<huffman_filter{huffman_filter::xor_previous, 2},
+        9, 9, 0, 0, 9, 9, 0, 0, 9, 9, 0, 0, 3, 3>("XOR filter, stride 2");
+
+    // Delta coding turns a ramp into one repeated value
+    constexpr auto ramp = huffman_compress_array_filtered<huffman_filter{huffman_filter::delta},
+        unsigned char, 0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45, 48, 51, 54,
+        57, 60, 63, 66, 69, 72, 75, 78, 81, 84, 87, 90, 93, 96, 99, 102, 105, 108, 111>;
+    static_assert(ramp.compressed_size() < ramp.uncompressed_size() / 2);
+
+    return report();
+}
@@ -0,0 +1,32 @@
+/**
+ * find.cpp - Searches compressed data without decompressing it.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#define TEXT "hello world, hello hello world, well well hello world. " \
+             "hello world, hello hello world, well well hello world. "
+
+int main()
+{
+    constexpr auto data = huffman_compress<TEXT>;
+    static_assert(data.bytes_saved() > 0);
+    constexpr auto text = literal(TEXT);
+
+    for (std::string_view pattern : {"hello", "world.", "well well hello", "lo wo",
+        "hello world. hello", "", "goodbye", "worlds", "h"})
+    {
+        auto expected = text.find(pattern);
+        auto found = data.find(pattern);
+        check(expected == std::string_view::npos ? found == data.npos : found == expected,
+            "find()");
+        check(data.contains(pattern) == (expected != std::string_view::npos), "contains()");
+    }
+
+    constexpr auto raw = huffman_compress<"abc">;
+    check(raw.find("bc") == 1 && !raw.contains("cb"), "find() in uncompressed data");
+
+    return report();
+}
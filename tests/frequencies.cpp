@@ -0,0 +1,71 @@
+/**
+ * frequencies.cpp - Compresses literals with codes built from given symbol
+ * frequencies.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#define LINE "she sells sea shells by the sea shore. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE
+
+constexpr huffman_options trained {
+    .separate_tree = true,
+    .frequencies = huffman_frequencies_of<TEXT>
+};
+
+// A model covering every byte value, skewed towards text. Its decode tree
+// is too wide for one-byte child distances.
+constexpr auto skewed = [] {
+    huffman_frequencies f;
+    for (int i = 0; i < 256; i++)
+        f.counts[i] = i == 0 ? 1 : 2;
+    for (int c = 'a'; c <= 'z'; c++)
+        f.counts[c] = 100000;
+    f.counts[' '] = 100000;
+    return f;
+}();
+
+// Every byte value, then some text.
+consteval auto every_byte() noexcept
+{
+    char bytes[256 + sizeof(LINE)] = {};
+    for (int i = 0; i < 256; i++)
+        bytes[i] = static_cast<char>(i);
+    for (std::size_t i = 0; i < sizeof(LINE); i++)
+        bytes[256 + i] = LINE[i];
+    return detail::huffman_string_container(bytes);
+}
+
+constexpr auto all = every_byte();
+
+int main()
+{
+    constexpr auto short_text = huffman_compress<"she sells", trained>;
+    constexpr auto other_text = huffman_compress<"sea shore", trained>;
+    static_assert(short_text.bytes_saved() > 0 && other_text.bytes_saved() > 0);
+    check(equals(short_text, literal("she sells")) && equals(other_text, literal("sea shore")),
+        "trained frequencies");
+    check(short_text.decode_tree() == other_text.decode_tree(), "trained tree is shared");
+
+    // Values missing from the model still get codes
+    constexpr auto unseen = huffman_compress<"she sells QQ", trained>;
+    check(equals(unseen, literal("she sells QQ")), "values missing from the model");
+
+    // A tree that cannot be stored leaves the data raw, rather than wrong
+    constexpr auto wide = huffman_compress<"hello world \x99\x98 hello world hello world "
+        "hello world hello world hello world hello world hello world",
+        {.separate_tree = true, .frequencies = skewed}>;
+    static_assert(wide.bytes_saved() == 0);
+    check(equals(wide, literal("hello world \x99\x98 hello world hello world "
+        "hello world hello world hello world hello world hello world")), "skewed model");
+
+    constexpr auto wide_all = huffman_compress<all, {.frequencies = skewed}>;
+    check(equals(wide_all, std::string_view(all.data, all.size())), "skewed model, every byte");
+
+    constexpr auto even_all = huffman_compress<all, {.frequencies = huffman_frequencies_of<all>}>;
+    check(equals(even_all, std::string_view(all.data, all.size())), "even model, every byte");
+
+    return report();
+}
@@ -0,0 +1,28 @@
+/**
+ * generator.cpp - Decodes a literal a chunk at a time with decode_chunks().
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/generator.hpp>
+
+#define TEXT "hello world, hello hello world, well well hello world. " \
+             "hello world, hello hello world, well well hello world. "
+
+int main()
+{
+    constexpr auto data = huffman_compress<TEXT>;
+    static_assert(data.bytes_saved() > 0);
+
+    for (std::size_t size : {0, 1, 7, 1000}) {
+        std::string out;
+        auto chunks = decode_chunks(data, size);
+        while (chunks.next()) {
+            check(chunks.chunk().size() <= std::max<std::size_t>(size, 1), "chunk size");
+            out.append(chunks.chunk().begin(), chunks.chunk().end());
+        }
+        check(out == literal(TEXT), "decode_chunks()");
+    }
+
+    return report();
+}
@@ -0,0 +1,36 @@
+/**
+ * inflate.cpp - Inflates streams from huffman_compress_deflate with
+ * huffman_inflate(), without zlib.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/deflate.hpp>
+#include <consteval_huffman/inflate.hpp>
+
+#define LINE "<tr><td class=\"name\">sensor</td><td class=\"value\">3.14</td></tr>\n"
+#define PAGE "<html><body><table>\n" LINE LINE LINE LINE LINE LINE "</table></body></html>\n"
+
+constexpr std::string_view page = PAGE;
+constexpr auto gzip = huffman_compress_deflate<PAGE>;
+constexpr auto zlib = huffman_compress_deflate<PAGE, {huffman_deflate_options::zlib}>;
+constexpr auto raw = huffman_compress_deflate<PAGE, {huffman_deflate_options::raw, false}>;
+
+int main()
+{
+    unsigned char buffer[page.size()];
+    check(equals(huffman_inflate(gzip.bytes(), buffer), page), "gzip");
+    check(equals(huffman_inflate(zlib.bytes(), buffer, huffman_deflate_options::zlib), page),
+        "zlib");
+    check(equals(huffman_inflate(raw.bytes(), buffer, huffman_deflate_options::raw), page),
+        "raw DEFLATE");
+
+    check(huffman_inflate(gzip.bytes().first(gzip.size() - 1), buffer).empty(),
+        "truncated stream");
+    check(huffman_inflate(gzip.bytes(), std::span(buffer).first(page.size() - 1)).empty(),
+        "short output buffer");
+    check(huffman_inflate(zlib.bytes(), buffer, huffman_deflate_options::gzip).empty(),
+        "wrong framing");
+
+    return report();
+}
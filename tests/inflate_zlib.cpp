@@ -0,0 +1,162 @@
+/**
+ * inflate_zlib.cpp - Checks huffman_inflate() against zlib: streams that
+ * zlib writes (every level and strategy, in each framing) must inflate with
+ * huffman_inflate(). Truncated and corrupted streams must fail cleanly.
+ * Finally, compares decoding speed on a larger stream.
+ */
+
+#include <consteval_huffman/inflate.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+using bytes = std::vector<unsigned char>;
+using format = huffman_deflate_options::format_type;
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, int detail = 0)
+{
+    if (!ok) {
+        std::printf("FAIL: %s (%d)\n", what, detail);
+        failures++;
+    }
+}
+
+// zlib's windowBits for each framing
+static int window_bits(format f)
+{
+    return f == huffman_deflate_options::raw ? -15 :
+           f == huffman_deflate_options::zlib ? 15 : 15 + 16;
+}
+
+static bytes zlib_deflate(const bytes& in, format f, int level, int strategy)
+{
+    z_stream z {};
+    deflateInit2(&z, level, Z_DEFLATED, window_bits(f), 8, strategy);
+    bytes out (deflateBound(&z, in.size()) + 32);
+    z.next_in = const_cast<unsigned char *>(in.data());
+    z.avail_in = static_cast<uInt>(in.size());
+    z.next_out = out.data();
+    z.avail_out = static_cast<uInt>(out.size());
+    deflate(&z, Z_FINISH);
+    out.resize(z.total_out);
+    deflateEnd(&z);
+    return out;
+}
+
+static std::vector<bytes> make_inputs()
+{
+    std::mt19937 rng (1);
+    std::vector<bytes> inputs;
+
+    constexpr std::string_view words[] = {"the ", "quick ", "brown ", "fox ",
+        "jumps ", "over ", "lazy ", "dog\n"};
+    bytes text;
+    while (text.size() < 100000) {
+        auto w = words[rng() % std::size(words)];
+        text.insert(text.end(), w.begin(), w.end());
+    }
+    inputs.push_back(std::move(text));
+
+    bytes noise (20000);
+    for (auto& c : noise)
+        c = static_cast<unsigned char>(rng());
+    inputs.push_back(std::move(noise));
+
+    bytes runs;
+    while (runs.size() < 50000)
+        runs.insert(runs.end(), 1 + rng() % 300, static_cast<unsigned char>(rng() % 4));
+    inputs.push_back(std::move(runs));
+
+    inputs.push_back(bytes(70000, 0));
+    inputs.push_back(bytes {42});
+    inputs.push_back(bytes {});
+    return inputs;
+}
+
+static void test_zlib_streams()
+{
+    constexpr int strategies[] = {Z_DEFAULT_STRATEGY, Z_FILTERED, Z_HUFFMAN_ONLY, Z_RLE, Z_FIXED};
+    constexpr format formats[] = {huffman_deflate_options::raw,
+        huffman_deflate_options::zlib, huffman_deflate_options::gzip};
+
+    std::mt19937 rng (2);
+    int input = 0;
+    for (const auto& in : make_inputs()) {
+        input++;
+        bytes out (in.size() + 1);
+        for (auto f : formats) {
+            for (int level = 0; level <= 9; level++) {
+                for (auto strategy : strategies) {
+                    auto stream = zlib_deflate(in, f, level, strategy);
+                    auto result = huffman_inflate(stream, out, f);
+                    check(std::equal(result.begin(), result.end(), in.begin(), in.end()),
+                        "inflating zlib's stream", input * 1000 + level * 10 + strategy);
+
+                    // An exact-size buffer works, but one byte less must fail
+                    bytes exact (in.size());
+                    check(huffman_inflate(stream, exact, f).size() == in.size(),
+                        "exact-size output", input);
+                    if (!in.empty()) {
+                        check(huffman_inflate(stream, std::span(exact).first(in.size() - 1),
+                            f).empty(), "short output", input);
+                    }
+                }
+            }
+
+            // Truncation must fail; corruption may not be detected for raw
+            // streams, but must never write outside of the buffer
+            auto stream = zlib_deflate(in, f, 6, Z_DEFAULT_STRATEGY);
+            for (std::size_t n = 0; n < stream.size(); n += 1 + stream.size() / 200) {
+                check(huffman_inflate(std::span(stream).first(n), out, f).empty(),
+                    "truncated stream", input);
+            }
+            for (int i = 0; i < 200; i++) {
+                auto corrupt = stream;
+                corrupt[rng() % corrupt.size()] ^= static_cast<unsigned char>(1 << (rng() % 8));
+                auto result = huffman_inflate(corrupt, out, f);
+                check(result.empty() || result.data() == out.data(), "corrupted stream", input);
+            }
+        }
+    }
+}
+
+static void compare_speed()
+{
+    auto in = make_inputs().front();
+    auto stream = zlib_deflate(in, huffman_deflate_options::zlib, 9, Z_DEFAULT_STRATEGY);
+    bytes out (in.size());
+    constexpr int runs = 50;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++)
+        huffman_inflate(stream, out, huffman_deflate_options::zlib);
+    auto mid = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        uLongf size = out.size();
+        uncompress(out.data(), &size, stream.data(), stream.size());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto rate = [&](auto t) {
+        return in.size() * runs / 1e6 / std::chrono::duration<double>(t).count();
+    };
+    std::printf("inflating %zu bytes: huffman_inflate %.1f MB/s, zlib %.1f MB/s\n",
+        in.size(), rate(mid - start), rate(end - mid));
+}
+
+int main()
+{
+    test_zlib_streams();
+    compare_speed();
+
+    std::printf("%d failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
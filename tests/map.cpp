@@ -0,0 +1,30 @@
+/**
+ * map.cpp - Looks up keys in a compressed map.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/map.hpp>
+
+int main()
+{
+    constexpr huffman_map<"apple", "A red fruit.", "banana", "A yellow fruit.",
+        "cherry", "", "k1", "v1", "k2", "v2", "k3", "v3", "k4", "v4", "k5", "v5"> fruits;
+    static_assert(fruits.size() == 8);
+
+    auto banana = fruits.find("banana");
+    auto cherry = fruits.find("cherry");
+    check(banana && equals(*banana, "A yellow fruit."), "huffman_map");
+    check(cherry && equals(*cherry, ""), "huffman_map with an empty value");
+    for (auto key : {"k1", "k2", "k3", "k4", "k5"}) {
+        auto value = fruits.find(key);
+        check(value && equals(*value, std::string("v") + key[1]), "huffman_map");
+    }
+    for (auto key : {"kiwi", "", "app", "apple ", "k6"})
+        check(!fruits.contains(key), "huffman_map misses");
+
+    constexpr huffman_map<"only", "one entry"> single;
+    check(single.contains("only") && !single.contains("on"), "huffman_map of one entry");
+
+    return report();
+}
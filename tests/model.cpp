@@ -0,0 +1,33 @@
+/**
+ * model.cpp - Codes run-time messages with a model trained at compile-time.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/model.hpp>
+
+#include <vector>
+
+using model = huffman_model<R"({"id": 12345, "name": "sensor-a", "value": 3.14159, "status": "ok"}
+{"id": 12346, "name": "sensor-b", "value": 2.71828, "status": "error"})">;
+
+int main()
+{
+    for (std::string_view message : {R"({"id": 99, "name": "sensor-z", "value": 1.5, "status": "ok"})",
+        "UNSEEN \xff\x01 QQ", "", "a"})
+    {
+        auto in = reinterpret_cast<const unsigned char *>(message.data());
+        std::vector<unsigned char> buffer (model::max_encoded_size(message.size()));
+        auto used = model::encode(std::span(in, message.size()), buffer.data());
+
+        // Decode from an exact-size copy, so overreads are caught by sanitizers
+        std::vector<unsigned char> encoded (buffer.begin(), buffer.begin() + used);
+        std::vector<unsigned char> decoded (message.size());
+        model::decode(encoded.data(), decoded);
+        check(equals(decoded, message), "huffman_model");
+        if (message.size() > 20)
+            check(used < message.size() * 3 / 4, "huffman_model compresses seen text");
+    }
+
+    return report();
+}
@@ -0,0 +1,38 @@
+/**
+ * parallel.cpp - Decodes several literals at once with decode_all().
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/parallel.hpp>
+
+#include <vector>
+
+#define TEXT "hello world, hello hello world, well well hello world. " \
+             "hello world, hello hello world, well well hello world. "
+#define RUNS "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaabbbbbbbbbbbbbbbbcccc"
+
+constexpr auto text = huffman_compress<TEXT>;
+constexpr auto runs = huffman_compress<RUNS>;
+constexpr auto raw = huffman_compress<"raw">;
+
+int main()
+{
+    static_assert(text.bytes_saved() > 0 && runs.bytes_saved() > 0);
+
+    for (unsigned int threads : {0, 1, 2, 8}) {
+        std::vector<huffman_decode_job> jobs {text, runs, raw, text};
+        std::vector<unsigned char> arena (2 * text.uncompressed_size() +
+            runs.uncompressed_size() + raw.uncompressed_size());
+        check(decode_all(jobs, arena, threads), "decode_all()");
+        check(equals(jobs[0].output, literal(TEXT)) && equals(jobs[1].output, literal(RUNS)) &&
+            equals(jobs[2].output, literal("raw")) && equals(jobs[3].output, literal(TEXT)),
+            "decode_all() output");
+    }
+
+    std::vector<huffman_decode_job> jobs {text, runs};
+    std::vector<unsigned char> small (text.uncompressed_size());
+    check(!decode_all(jobs, small), "decode_all() with a small arena");
+
+    return report();
+}
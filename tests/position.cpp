@@ -0,0 +1,25 @@
+/**
+ * position.cpp - Saves decoder positions and resumes decoding from them.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#define TEXT "hello world, hello hello world, well well hello world. " \
+             "hello world, hello hello world, well well hello world. "
+
+int main()
+{
+    constexpr auto data = huffman_compress<TEXT>;
+    static_assert(data.bytes_saved() > 0);
+    constexpr auto text = literal(TEXT);
+
+    std::size_t i = 0;
+    for (auto it = data.begin(); it != data.end(); ++it, ++i) {
+        auto resumed = data.at(it.position());
+        check(std::string(resumed, data.end()) == text.substr(i), "at(position())");
+    }
+
+    return report();
+}
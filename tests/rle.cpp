@@ -0,0 +1,28 @@
+/**
+ * rle.cpp - Round-trips data through the run-length encoding stage.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/transform.hpp>
+
+#include <algorithm>
+
+int main()
+{
+    // Runs of two expand by half when run-length encoded
+    constexpr auto pairs = huffman_compress_rle<"aabbccddeeffgghhiijj">;
+    check(equals(pairs, literal("aabbccddeeffgghhiijj")), "huffman_compress_rle of pairs");
+
+    constexpr auto runs = huffman_compress_array_rle<unsigned char,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7>;
+    static_assert(runs.uses_rle && runs.compressed_size() < runs.uncompressed_size());
+    unsigned char out[runs.uncompressed_size()];
+    runs.decode(out);
+    check(std::count(out, out + sizeof(out), 0) == sizeof(out) - 1 && out[sizeof(out) - 1] == 7,
+        "huffman_compress_array_rle decode()");
+    check(std::ranges::equal(runs, out), "huffman_compress_array_rle iteration");
+
+    return report();
+}
@@ -0,0 +1,44 @@
+/**
+ * roundtrip.cpp - Compresses literals and arrays and checks that they
+ * decode back to the original.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#include <algorithm>
+
+#define TEXT "hello world, hello hello world, well well hello world. " \
+             "hello world, hello hello world, well well hello world. " \
+             "hello world, hello hello world, well well hello world. " \
+             "the end"
+#define HIGH "h\xe9llo w\xf6rld, h\xe9llo h\xe9llo. "
+
+int main()
+{
+    constexpr auto data = huffman_compress<TEXT>;
+    static_assert(data.bytes_saved() > 0);
+    check(equals(data, literal(TEXT)), "huffman_compress");
+    check(equals(data.decoded(), literal(TEXT)), "decoded()");
+
+    check(equals("\0\x01 Non-text data works too!"_huffman,
+        literal("\0\x01 Non-text data works too!")), "_huffman");
+
+    constexpr auto raw = huffman_compress<"abc">;
+    static_assert(raw.bytes_saved() == 0);
+    check(equals(raw, literal("abc")), "uncompressed literal");
+
+    constexpr auto high = huffman_compress<HIGH HIGH HIGH HIGH HIGH HIGH HIGH HIGH>;
+    static_assert(high.bytes_saved() > 0);
+    check(equals(high, literal(HIGH HIGH HIGH HIGH HIGH HIGH HIGH HIGH)), "values above 0x7F");
+
+    constexpr auto bytes = huffman_compress_array<unsigned char, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 0, 0, 0, 0>;
+    static_assert(bytes.bytes_saved() > 0);
+    constexpr unsigned char expected[] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 0, 0, 0, 0};
+    check(std::ranges::equal(bytes, expected), "huffman_compress_array");
+
+    return report();
+}
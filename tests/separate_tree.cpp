@@ -0,0 +1,34 @@
+/**
+ * separate_tree.cpp - Decodes literals whose decode tree is stored apart
+ * from the payload.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#include <cstdint>
+
+#define LINE "she sells sea shells by the sea shore. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE LINE
+#define SHUFFLED "sea shells she sells by the sea shore. "
+
+constexpr auto data = huffman_compress<TEXT, {.separate_tree = true}>;
+// Same frequencies, so the same tree
+constexpr auto shuffled = huffman_compress<SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED
+    SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED SHUFFLED
+    SHUFFLED, {.separate_tree = true}>;
+
+int main()
+{
+    static_assert(data.bytes_saved() > 0 && shuffled.bytes_saved() > 0);
+    check(equals(data, literal(TEXT)), "separate_tree");
+    check(equals(data.decoded(), literal(TEXT)), "separate_tree decoded()");
+
+    auto tree = reinterpret_cast<std::uintptr_t>(data.decode_tree());
+    check(tree % 64 == 0, "separate tree is cache-line aligned");
+    check(data.decode_tree() == shuffled.decode_tree(), "identical trees are shared");
+    static_assert(data.layout().separate_tree);
+
+    return report();
+}
@@ -0,0 +1,64 @@
+/**
+ * stream.cpp - Codes run-time data with huffman_stream_encoder and decodes
+ * it with huffman_stream_decoder.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/stream.hpp>
+
+#include <random>
+#include <vector>
+
+using bytes = std::vector<unsigned char>;
+
+static bytes encode(const bytes& in, std::size_t block_size, std::size_t chunk)
+{
+    bytes out;
+    huffman_stream_encoder encoder (out, block_size);
+    for (std::size_t i = 0; i < in.size(); i += chunk)
+        encoder.write(std::span(in).subspan(i, std::min(chunk, in.size() - i)));
+    encoder.flush();
+    return out;
+}
+
+static bytes decode(const bytes& stream)
+{
+    bytes out;
+    huffman_stream_decoder decoder (stream);
+    for (auto block = decoder.next(); !block.empty(); block = decoder.next())
+        out.insert(out.end(), block.begin(), block.end());
+    return out;
+}
+
+int main()
+{
+    std::mt19937 rng (1);
+    constexpr std::string_view words[] = {"the ", "quick ", "brown ", "fox ",
+        "jumps ", "over ", "lazy ", "dog\n"};
+    bytes text;
+    while (text.size() < 50000) {
+        auto w = words[rng() % std::size(words)];
+        text.insert(text.end(), w.begin(), w.end());
+    }
+    bytes noise (10000);
+    for (auto& c : noise)
+        c = static_cast<unsigned char>(rng());
+
+    auto coded = encode(text, 4096, 1000);
+    check(coded.size() < text.size() * 3 / 4, "huffman_stream_encoder compresses text");
+    check(decode(coded) == text, "huffman_stream text");
+    check(decode(encode(text, 65536, 77777)) == text, "huffman_stream large blocks");
+    check(decode(encode(noise, 4096, 4096)) == noise, "huffman_stream noise");
+    check(decode(encode(bytes(10000, 'a'), 4096, 10000)) == bytes(10000, 'a'),
+        "huffman_stream one value");
+    check(decode(encode({}, 4096, 1)).empty(), "huffman_stream empty");
+    check(decode(encode(bytes(text.begin(), text.begin() + 100), 0, 7)) ==
+        bytes(text.begin(), text.begin() + 100), "huffman_stream with block_size 0");
+
+    // A block of unknown type is corrupt, and ends decoding
+    coded[0] = 7;
+    check(decode(coded).empty(), "huffman_stream unknown block type");
+
+    return report();
+}
@@ -0,0 +1,24 @@
+/**
+ * string_table.cpp - Looks up strings in a compressed string table.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/string_table.hpp>
+
+int main()
+{
+    constexpr huffman_string_table<"File not found", "", "Permission denied", "Disk full",
+        "File exists", "Not a directory", "Is a directory", "File too large"> messages;
+    static_assert(messages.size() == 8);
+
+    constexpr std::string_view expected[] = {"File not found", "", "Permission denied",
+        "Disk full", "File exists", "Not a directory", "Is a directory", "File too large"};
+    for (std::size_t i = 0; i < messages.size(); i++)
+        check(equals(messages[i], expected[i]), "huffman_string_table");
+
+    constexpr huffman_string_table<"only"> single;
+    check(equals(single[0], "only"), "huffman_string_table of one string");
+
+    return report();
+}
@@ -0,0 +1,31 @@
+/**
+ * worth.cpp - Checks the options that decide whether compressing pays off.
+ */
+
+#include "check.h"
+
+#include <consteval_huffman/consteval_huffman.hpp>
+
+#define LINE "she sells sea shells by the sea shore. "
+#define TEXT LINE LINE LINE LINE LINE LINE LINE LINE
+
+constexpr auto plain = huffman_compress<TEXT>;
+constexpr auto saved = plain.bytes_saved();
+constexpr auto enough_bytes = huffman_compress<TEXT, {.min_saved_bytes = saved}>;
+constexpr auto too_few_bytes = huffman_compress<TEXT, {.min_saved_bytes = saved + 1}>;
+constexpr auto too_few_percent = huffman_compress<TEXT, {.min_saved_percent = 90}>;
+constexpr auto too_costly = huffman_compress<TEXT, {.decode_cost = 1000}>;
+
+int main()
+{
+    static_assert(saved > 0 && enough_bytes.bytes_saved() == saved);
+    static_assert(too_few_bytes.bytes_saved() == 0 && too_few_percent.bytes_saved() == 0 &&
+        too_costly.bytes_saved() == 0);
+
+    check(equals(enough_bytes, literal(TEXT)), "compressed literal");
+    check(equals(too_few_bytes, literal(TEXT)) && equals(too_few_percent, literal(TEXT)) &&
+        equals(too_costly, literal(TEXT)), "literals kept raw by options");
+    check(too_costly.size() == too_costly.uncompressed_size(), "raw literal size");
+
+    return report();
+}